@@ -22,6 +22,8 @@
 
 #include "src/chess/chess.h"
 #include "src/displayserver/displayserver.h"
+#include "src/perft/perft.h"
+#include "src/pgn/pgnPipeline.h"
 using namespace std;
 
 using boost::asio::ip::tcp;
@@ -61,10 +63,67 @@ namespace
             } catch(...) {}
         }
     }
+
+    // perft <fen|startpos> <depth> [--divide] [--threads N] [--hash MB] [--lockless]
+    int runPerft(int argc, char** argv)
+    {
+        cchess_perft::PerftOptions options;
+        bool isValid = argc >= 4 && *argv[3] && isStringNumber(argv[3]);
+        if(isValid)
+            options.depth = getStringNumber(argv[3]);
+
+        for(int i = 4; i < argc && isValid; ++i) {
+            string option(argv[i]);
+            if(option == "--divide") {
+                options.divide = true;
+            } else if(option == "--threads" && i + 1 < argc && isStringNumber(argv[i + 1])) {
+                options.threads = getStringNumber(argv[++i]);
+            } else if(option == "--hash" && i + 1 < argc && isStringNumber(argv[i + 1])) {
+                options.hashSizeInMB = getStringNumber(argv[++i]);
+            } else if(option == "--lockless") {
+                options.isHashLockless = true;
+            } else {
+                isValid = false;
+            }
+        }
+
+        if(!isValid) {
+            cerr << "Usage: " << argv[0] << " perft <fen|startpos> <depth> [--divide] [--threads N] [--hash MB] [--lockless]" << endl;
+            return 1;
+        }
+
+        return cchess_perft::runPerft(argv[2], options, cout) ? 0 : 1;
+    }
+
+    // pgn <file> [--threads N]
+    int runPgnValidation(int argc, char** argv)
+    {
+        cchess_pgn::PgnValidationOptions options;
+        bool isValid = true;
+        for(int i = 3; i < argc && isValid; ++i) {
+            string option(argv[i]);
+            if(option == "--threads" && i + 1 < argc && isStringNumber(argv[i + 1]))
+                options.threads = getStringNumber(argv[++i]);
+            else
+                isValid = false;
+        }
+
+        if(!isValid) {
+            cerr << "Usage: " << argv[0] << " pgn <file> [--threads N]" << endl;
+            return 1;
+        }
+
+        return cchess_pgn::runPgnValidation(argv[2], options, cout) ? 0 : 1;
+    }
 }
 
 int main(int argc, char** argv)
 {
+    if(argc >= 3 && string(argv[1]) == "pgn")
+        return runPgnValidation(argc, argv);
+    if(argc >= 2 && string(argv[1]) == "perft")
+        return runPerft(argc, argv);
+
     if(argc == 3) {
         if(string(argv[1]) == "-ds")
             runDisplayServer(string(argv[2]));
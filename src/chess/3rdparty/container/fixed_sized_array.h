@@ -18,6 +18,7 @@
 #define GUARD_MAR_container_fixed_sized_array_H
 
 // standard headers
+#include <initializer_list>
 #include <memory>
 #include <type_traits>
 
@@ -95,6 +96,52 @@ namespace container
 
         pointer m_data;
     };
+
+    // storage policy that keeps the elements inside the array object instead of on the heap,
+    // the array is then trivially copyable when T is
+    struct inline_storage {};
+
+    template<class T,
+             std::size_t Size>
+    class fixed_sized_array<T, Size, inline_storage>
+    {
+    public:
+        typedef T                                           value_type;
+        typedef T*                                          pointer;
+        typedef const T*                                    const_pointer;
+        typedef T&                                          reference;
+        typedef const T&                                    const_reference;
+        typedef std::size_t                                 size_type;
+        typedef T*                                          iterator;
+        typedef const T*                                    const_iterator;
+        typedef std::reverse_iterator<iterator>             reverse_iterator;
+        typedef std::reverse_iterator<const_iterator>       const_reverse_iterator;
+
+        fixed_sized_array() = default;
+        fixed_sized_array(std::initializer_list<T> il);
+        fixed_sized_array(const value_type& v);
+
+        iterator begin() MAR_NO_EXCEPT { return m_data; }
+        const_iterator begin() const MAR_NO_EXCEPT  { return m_data; }
+        reverse_iterator rbegin() MAR_NO_EXCEPT { return reverse_iterator(end()); }
+        const_reverse_iterator rbegin() const MAR_NO_EXCEPT { return const_reverse_iterator(end()); }
+        iterator end() MAR_NO_EXCEPT { return m_data + Size; }
+        const_iterator end() const MAR_NO_EXCEPT { return m_data + Size; }
+        reverse_iterator rend() MAR_NO_EXCEPT { return reverse_iterator(begin()); }
+        const_reverse_iterator rend() const MAR_NO_EXCEPT { return const_reverse_iterator(begin()); }
+
+        reference operator[](size_type n) MAR_NO_EXCEPT { return m_data[n]; }
+        const_reference operator[](size_type n) const MAR_NO_EXCEPT { return m_data[n]; }
+
+        void swap(fixed_sized_array& other) MAR_NO_EXCEPT;
+
+        pointer data() MAR_NO_EXCEPT { return m_data; }
+        const_pointer data() const MAR_NO_EXCEPT { return m_data; }
+        constexpr size_type capacity() const MAR_NO_EXCEPT { return Size; }
+
+    private:
+        T m_data[Size];
+    };
 }
 }
 
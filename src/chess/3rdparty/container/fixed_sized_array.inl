@@ -113,5 +113,24 @@ namespace container
     {
         std::swap(m_data, other.m_data);
     }
+
+    template<class T, std::size_t Size>
+    fixed_sized_array<T, Size, inline_storage>::fixed_sized_array(std::initializer_list<T> il)
+    {
+        mar_assert(il.size() == Size, "Sizes do not match");
+        std::copy(il.begin(), il.end(), m_data);
+    }
+
+    template<class T, std::size_t Size>
+    fixed_sized_array<T, Size, inline_storage>::fixed_sized_array(const value_type& v)
+    {
+        std::fill(m_data, m_data + Size, v);
+    }
+
+    template<class T, std::size_t Size>
+    void fixed_sized_array<T, Size, inline_storage>::swap(fixed_sized_array& other) MAR_NO_EXCEPT
+    {
+        std::swap_ranges(m_data, m_data + Size, other.m_data);
+    }
 }
 }
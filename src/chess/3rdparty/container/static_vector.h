@@ -0,0 +1,113 @@
+/**********
+ *
+ *     This program is free software: you can redistribute it and/or modify
+ *     it under the terms of the GNU General Public License as published by
+ *     the Free Software Foundation, either version 3 of the License, or
+ *     (at your option) any later version.
+ * 
+ *     This program is distributed in the hope that it will be useful,
+ *     but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *     MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *     GNU General Public License for more details.
+ * 
+ *     You should have received a copy of the GNU General Public License
+ *     along with this program.  If not, see <https://www.gnu.org/licenses/>. 
+ *
+ **********/
+#ifndef GUARD_MAR_container_static_vector_H
+#define GUARD_MAR_container_static_vector_H
+
+// standard headers
+#include <cstddef>
+#include <initializer_list>
+#include <iterator>
+#include <type_traits>
+
+#ifndef MAR_NULL
+#if __cplusplus >= 201103L
+#define MAR_NULL nullptr
+#else
+#define MAR_NULL 0
+#endif // C++11
+#endif // MAR_NULL
+
+#ifndef MAR_NO_EXCEPT
+#if __cplusplus >= 201103L
+#define MAR_NO_EXCEPT noexcept
+#else
+#define MAR_NO_EXCEPT
+#endif // C++11
+#endif // MAR_NO_EXCEPT
+
+namespace mar
+{
+namespace container
+{
+    // a vector with a fixed capacity whose elements are stored in place,
+    // so it never touches the heap
+    template<class T,
+             std::size_t Capacity>
+    class static_vector
+    {
+    public:
+        typedef T                                           value_type;
+        typedef T*                                          pointer;
+        typedef const T*                                    const_pointer;
+        typedef T&                                          reference;
+        typedef const T&                                    const_reference;
+        typedef std::size_t                                 size_type;
+        typedef T*                                          iterator;
+        typedef const T*                                    const_iterator;
+        typedef std::reverse_iterator<iterator>             reverse_iterator;
+        typedef std::reverse_iterator<const_iterator>       const_reverse_iterator;
+
+        static_vector() MAR_NO_EXCEPT;
+        static_vector(const static_vector& rhs);
+        static_vector(static_vector&& rhs) MAR_NO_EXCEPT(std::is_nothrow_move_constructible<T>());
+        static_vector& operator=(const static_vector& rhs);
+        static_vector& operator=(static_vector&& rhs) MAR_NO_EXCEPT(std::is_nothrow_move_constructible<T>());
+        static_vector(std::initializer_list<T> il);
+        ~static_vector() MAR_NO_EXCEPT;
+
+        iterator begin() MAR_NO_EXCEPT { return data(); }
+        const_iterator begin() const MAR_NO_EXCEPT { return data(); }
+        reverse_iterator rbegin() MAR_NO_EXCEPT { return reverse_iterator(end()); }
+        const_reverse_iterator rbegin() const MAR_NO_EXCEPT { return const_reverse_iterator(end()); }
+        iterator end() MAR_NO_EXCEPT { return data() + m_size; }
+        const_iterator end() const MAR_NO_EXCEPT { return data() + m_size; }
+        reverse_iterator rend() MAR_NO_EXCEPT { return reverse_iterator(begin()); }
+        const_reverse_iterator rend() const MAR_NO_EXCEPT { return const_reverse_iterator(begin()); }
+
+        reference operator[](size_type n) MAR_NO_EXCEPT { return data()[n]; }
+        const_reference operator[](size_type n) const MAR_NO_EXCEPT { return data()[n]; }
+        reference front() MAR_NO_EXCEPT { return data()[0]; }
+        const_reference front() const MAR_NO_EXCEPT { return data()[0]; }
+        reference back() MAR_NO_EXCEPT { return data()[m_size - 1]; }
+        const_reference back() const MAR_NO_EXCEPT { return data()[m_size - 1]; }
+
+        void push_back(const value_type& value);
+        void push_back(value_type&& value);
+        template<class... Args> reference emplace_back(Args&&... args);
+        void pop_back() MAR_NO_EXCEPT;
+        void clear() MAR_NO_EXCEPT;
+
+        pointer data() MAR_NO_EXCEPT { return reinterpret_cast<pointer>(m_storage); }
+        const_pointer data() const MAR_NO_EXCEPT { return reinterpret_cast<const_pointer>(m_storage); }
+        size_type size() const MAR_NO_EXCEPT { return m_size; }
+        bool empty() const MAR_NO_EXCEPT { return m_size == 0; }
+        bool full() const MAR_NO_EXCEPT { return m_size == Capacity; }
+        constexpr size_type capacity() const MAR_NO_EXCEPT { return Capacity; }
+
+    private:
+        typedef typename std::aligned_storage<sizeof(T), alignof(T)>::type storage_type;
+
+        storage_type    m_storage[Capacity];
+        size_type       m_size;
+    };
+}
+}
+
+// definitions
+#include "static_vector.inl"
+
+#endif // GUARD_MAR_container_static_vector_H
@@ -0,0 +1,133 @@
+/**********
+ *
+ *     This program is free software: you can redistribute it and/or modify
+ *     it under the terms of the GNU General Public License as published by
+ *     the Free Software Foundation, either version 3 of the License, or
+ *     (at your option) any later version.
+ * 
+ *     This program is distributed in the hope that it will be useful,
+ *     but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *     MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *     GNU General Public License for more details.
+ * 
+ *     You should have received a copy of the GNU General Public License
+ *     along with this program.  If not, see <https://www.gnu.org/licenses/>. 
+ *
+ **********/
+// standard headers
+#include <assert.h>
+#include <new>
+#include <utility>
+
+// custom headers
+#include "../debug/assert.h"
+#include "static_vector.h"
+
+namespace mar
+{
+namespace container
+{
+    template<class T, std::size_t Capacity>
+    static_vector<T, Capacity>::static_vector() MAR_NO_EXCEPT :
+        m_size(0)
+    {
+    }
+
+    template<class T, std::size_t Capacity>
+    static_vector<T, Capacity>::static_vector(const static_vector& rhs) :
+        m_size(0)
+    {
+        for(const auto& value : rhs)
+            emplace_back(value);
+    }
+
+    template<class T, std::size_t Capacity>
+    static_vector<T, Capacity>::static_vector(static_vector&& rhs) MAR_NO_EXCEPT(std::is_nothrow_move_constructible<T>()) :
+        m_size(0)
+    {
+        for(auto& value : rhs)
+            emplace_back(std::move(value));
+        rhs.clear();
+    }
+
+    template<class T, std::size_t Capacity>
+    static_vector<T, Capacity>& static_vector<T, Capacity>::operator=(const static_vector& rhs)
+    {
+        if(this != &rhs) {
+            clear();
+            for(const auto& value : rhs)
+                emplace_back(value);
+        }
+
+        return *this;
+    }
+
+    template<class T, std::size_t Capacity>
+    static_vector<T, Capacity>& static_vector<T, Capacity>::operator=(static_vector&& rhs) MAR_NO_EXCEPT(std::is_nothrow_move_constructible<T>())
+    {
+        if(this != &rhs) {
+            clear();
+            for(auto& value : rhs)
+                emplace_back(std::move(value));
+            rhs.clear();
+        }
+
+        return *this;
+    }
+
+    template<class T, std::size_t Capacity>
+    static_vector<T, Capacity>::static_vector(std::initializer_list<T> il) :
+        m_size(0)
+    {
+        for(const auto& value : il)
+            emplace_back(value);
+    }
+
+    template<class T, std::size_t Capacity>
+    static_vector<T, Capacity>::~static_vector() MAR_NO_EXCEPT
+    {
+        clear();
+    }
+
+    template<class T, std::size_t Capacity>
+    void static_vector<T, Capacity>::push_back(const value_type& value)
+    {
+        emplace_back(value);
+    }
+
+    template<class T, std::size_t Capacity>
+    void static_vector<T, Capacity>::push_back(value_type&& value)
+    {
+        emplace_back(std::move(value));
+    }
+
+    template<class T, std::size_t Capacity>
+    template<class... Args>
+    typename static_vector<T, Capacity>::reference static_vector<T, Capacity>::emplace_back(Args&&... args)
+    {
+        mar_assert(m_size < Capacity, "Static vector has reached it's maximum size");
+        auto ptr = new (data() + m_size) value_type(std::forward<Args>(args)...);
+        ++m_size;
+
+        return *ptr;
+    }
+
+    template<class T, std::size_t Capacity>
+    void static_vector<T, Capacity>::pop_back() MAR_NO_EXCEPT
+    {
+        assert(m_size > 0);
+        --m_size;
+        data()[m_size].~value_type();
+    }
+
+    template<class T, std::size_t Capacity>
+    void static_vector<T, Capacity>::clear() MAR_NO_EXCEPT
+    {
+        if(!std::is_trivially_destructible<T>::value) {
+            for(size_type i = 0; i < m_size; ++i)
+                data()[i].~value_type();
+        }
+        m_size = 0;
+    }
+}
+}
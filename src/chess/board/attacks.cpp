@@ -0,0 +1,241 @@
+/**********
+ *
+ *     This program is free software: you can redistribute it and/or modify
+ *     it under the terms of the GNU General Public License as published by
+ *     the Free Software Foundation, either version 3 of the License, or
+ *     (at your option) any later version.
+ * 
+ *     This program is distributed in the hope that it will be useful,
+ *     but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *     MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *     GNU General Public License for more details.
+ * 
+ *     You should have received a copy of the GNU General Public License
+ *     along with this program.  If not, see <https://www.gnu.org/licenses/>. 
+ *
+ **********/
+// headers
+#include <assert.h>
+#include "attacks.h"
+
+namespace cchess
+{
+namespace detail
+{
+    SlidingAttacks BISHOP_ATTACKS[NUMBER_OF_SQUARES];
+    SlidingAttacks ROOK_ATTACKS[NUMBER_OF_SQUARES];
+
+namespace
+{
+    static constexpr std::size_t BISHOP_TABLE_SIZE = 0x1480;
+    static constexpr std::size_t ROOK_TABLE_SIZE = 0x19000;
+    static constexpr position_t BISHOP_DIRECTIONS[4][2] = { { 1, 1 }, { 1, -1 }, { -1, 1 }, { -1, -1 } };
+    static constexpr position_t ROOK_DIRECTIONS[4][2] = { { 1, 0 }, { -1, 0 }, { 0, 1 }, { 0, -1 } };
+    static constexpr position_t KNIGHT_OFFSETS[8][2] = { { -1, -2 }, { 1, -2 }, { -1, 2 }, { 1, 2 }, { -2, 1 }, { -2, -1 }, { 2, 1 }, { 2, -1 } };
+    static constexpr position_t KING_OFFSETS[8][2] = { { -1, -1 }, { 0, -1 }, { 1, -1 }, { -1, 0 }, { 1, 0 }, { -1, 1 }, { 0, 1 }, { 1, 1 } };
+    static constexpr position_t PAWN_DOWN_OFFSETS[2][2] = { { -1, -1 }, { 1, -1 } };
+    static constexpr position_t PAWN_UP_OFFSETS[2][2] = { { -1, 1 }, { 1, 1 } };
+    static constexpr position_t QUEEN_DIRECTIONS[8][2] = { { 1, 1 }, { 1, -1 }, { -1, 1 }, { -1, -1 }, { 1, 0 }, { -1, 0 }, { 0, 1 }, { 0, -1 } };
+
+    // magic numbers for the square layout used by the bitboards, any occupancy of the
+    // relevant squares multiplied by them maps to an index without a destructive collision
+    static constexpr bitboard_t BISHOP_MAGICS[NUMBER_OF_SQUARES] =
+    {
+        0x10102002004A1420ULL, 0x8020040400584008ULL, 0x10510800811201C8ULL, 0x5204042080000088ULL,
+        0x2204106880000002ULL, 0x1401042004000000ULL, 0x0400880410042004ULL, 0x0028208200A02020ULL,
+        0x1500241990010E00ULL, 0x8001200182020A40ULL, 0x40004101030B0000ULL, 0x8002041042000100ULL,
+        0x4010011041020038ULL, 0x0000010421044000ULL, 0x1500210808020A00ULL, 0x8000088400880520ULL,
+        0x0405004010040100ULL, 0x1005823210040108ULL, 0x2708008102040011ULL, 0x4048200404009100ULL,
+        0x0018104101400024ULL, 0x0003000601190101ULL, 0x8004803108491000ULL, 0x8014241200820800ULL,
+        0x0006E080100C3040ULL, 0x0501044A11041800ULL, 0x9020300008004045ULL, 0x0894080000220040ULL,
+        0x1001010083104000ULL, 0x5004030040900080ULL, 0x000400422C012400ULL, 0x0002128698404812ULL,
+        0x1010108404900440ULL, 0x0928021182084100ULL, 0x2006080409020024ULL, 0x1010202020180080ULL,
+        0xA010008200202200ULL, 0x2098015100019004ULL, 0x0002041440810811ULL, 0x802A02020000B098ULL,
+        0x0009015090004060ULL, 0x4000821082081001ULL, 0x0100210040420800ULL, 0x0800004010488A00ULL,
+        0x2000081104004040ULL, 0x4C8E029015000082ULL, 0x0420340322224842ULL, 0x1298260043400210ULL,
+        0x0000822802400008ULL, 0x00008A0101600000ULL, 0x3040003412080021ULL, 0x3040290220884800ULL,
+        0x4A1500401041004AULL, 0x8010200282020781ULL, 0x0020203142209091ULL, 0x0070300600902110ULL,
+        0x0040808800B62048ULL, 0x0000810400C44420ULL, 0x00080400440C0441ULL, 0x8340080020840411ULL,
+        0x0000000104208200ULL, 0x0000800810D00080ULL, 0x0400530411080200ULL, 0x4040702400932244ULL
+    };
+
+    static constexpr bitboard_t ROOK_MAGICS[NUMBER_OF_SQUARES] =
+    {
+        0x1080004008801020ULL, 0x0840092002C03000ULL, 0x1900200010400900ULL, 0x0880100008000480ULL,
+        0x4200100420080200ULL, 0x8100020100080400ULL, 0x0200040110886200ULL, 0x0200008040220411ULL,
+        0x0404800084400220ULL, 0x0000401000402000ULL, 0x0086001081220440ULL, 0x0408800800100280ULL,
+        0x000A001201040820ULL, 0x8848800200840080ULL, 0x4001000100040200ULL, 0x0442000102105084ULL,
+        0x9080010020804100ULL, 0x0040404000201009ULL, 0x0000808010002009ULL, 0x2200090021D00100ULL,
+        0x0008008008040080ULL, 0x0004004002010040ULL, 0x0011040008015042ULL, 0x00000A0001768104ULL,
+        0x0000800080204009ULL, 0x2010004140002001ULL, 0x9800200280100080ULL, 0x1000100080080080ULL,
+        0x0442000A00049020ULL, 0x2100040080020080ULL, 0x0800120400900148ULL, 0x0010040A00128541ULL,
+        0x2800804000800030ULL, 0x1010002000400041ULL, 0x4000200011004100ULL, 0x0610008410800800ULL,
+        0x0400802402800800ULL, 0xC100020080800400ULL, 0x0002000802000401ULL, 0x0182085882000401ULL,
+        0x0220204000808000ULL, 0x2860100040024022ULL, 0x0001002004110040ULL, 0x99101042000A0020ULL,
+        0x0004080004008080ULL, 0x0010040002008080ULL, 0x2012004881020004ULL, 0x8300842444820011ULL,
+        0x0088403882010200ULL, 0x0820400080210100ULL, 0x0110910040A00300ULL, 0x0801100280080480ULL,
+        0x0242009008200600ULL, 0x1002000489500200ULL, 0x0040800200010080ULL, 0x0091800041000080ULL,
+        0x0000209300488001ULL, 0x04C1002414824001ULL, 0x020020000B001041ULL, 0x7000100004200901ULL,
+        0x8002002004100802ULL, 0x30010002084C0007ULL, 0x0888221800813004ULL, 0x4000002840840112ULL
+    };
+
+    // the tables below only depend on the geometry of the board, so they are
+    // generated by the compiler and need no initialization when the program starts
+    template<std::size_t NumberOfOffsets>
+    constexpr square_table_type generateLeaperAttacks(const position_t (&offsets)[NumberOfOffsets][2])
+    {
+        square_table_type ret = {};
+        for(position_t square = 0; square < NUMBER_OF_SQUARES; ++square) {
+            for(const auto& offset : offsets) {
+                auto x = getSquareX(square) + offset[0];
+                auto y = getSquareY(square) + offset[1];
+                if(isSquareValid(x, y))
+                    ret[square] |= getSquareMask(getSquare(x, y));
+            }
+        }
+
+        return ret;
+    }
+
+    constexpr bitboard_t getRay(position_t square, position_t dx, position_t dy)
+    {
+        bitboard_t ret = EMPTY_BITBOARD;
+        auto x = getSquareX(square) + dx;
+        auto y = getSquareY(square) + dy;
+        while(isSquareValid(x, y)) {
+            ret |= getSquareMask(getSquare(x, y));
+            x += dx;
+            y += dy;
+        }
+
+        return ret;
+    }
+
+    // walks every ray from every square, the squares passed are the ones in between
+    constexpr square_pair_table_type generateSquarePairs(bool isLine)
+    {
+        square_pair_table_type ret = {};
+        for(position_t square = 0; square < NUMBER_OF_SQUARES; ++square) {
+            for(const auto& direction : QUEEN_DIRECTIONS) {
+                auto line = getRay(square, direction[0], direction[1]) |
+                            getRay(square, -direction[0], -direction[1]) |
+                            getSquareMask(square);
+
+                bitboard_t between = EMPTY_BITBOARD;
+                auto x = getSquareX(square) + direction[0];
+                auto y = getSquareY(square) + direction[1];
+                while(isSquareValid(x, y)) {
+                    auto toSquare = getSquare(x, y);
+                    ret[square][toSquare] = isLine ? line : between;
+                    between |= getSquareMask(toSquare);
+                    x += direction[0];
+                    y += direction[1];
+                }
+            }
+        }
+
+        return ret;
+    }
+
+    constexpr distance_table_type generateDistances()
+    {
+        distance_table_type ret = {};
+        for(position_t fromSquare = 0; fromSquare < NUMBER_OF_SQUARES; ++fromSquare) {
+            for(position_t toSquare = 0; toSquare < NUMBER_OF_SQUARES; ++toSquare) {
+                auto dx = getSquareX(toSquare) - getSquareX(fromSquare);
+                auto dy = getSquareY(toSquare) - getSquareY(fromSquare);
+                dx = dx < 0 ? -dx : dx;
+                dy = dy < 0 ? -dy : dy;
+                ret[fromSquare][toSquare] = static_cast<unsigned char>(dx > dy ? dx : dy);
+            }
+        }
+
+        return ret;
+    }
+
+    bitboard_t BISHOP_TABLE[BISHOP_TABLE_SIZE];
+    bitboard_t ROOK_TABLE[ROOK_TABLE_SIZE];
+
+    // walks every ray until it hits the edge of the board or an occupied square
+    bitboard_t getSlidingAttacks(const position_t (&directions)[4][2], position_t square, bitboard_t occupancy)
+    {
+        bitboard_t ret = EMPTY_BITBOARD;
+        for(const auto& direction : directions) {
+            auto x = getSquareX(square) + direction[0];
+            auto y = getSquareY(square) + direction[1];
+            while(isSquareValid(x, y)) {
+                auto mask = getSquareMask(getSquare(x, y));
+                ret |= mask;
+                if(occupancy & mask)
+                    break;
+
+                x += direction[0];
+                y += direction[1];
+            }
+        }
+
+        return ret;
+    }
+
+    // the squares on a ray that can block it, the last square before the edge never blocks anything
+    bitboard_t getRelevantOccupancy(const position_t (&directions)[4][2], position_t square)
+    {
+        bitboard_t ret = EMPTY_BITBOARD;
+        for(const auto& direction : directions) {
+            auto x = getSquareX(square) + direction[0];
+            auto y = getSquareY(square) + direction[1];
+            while(isSquareValid(x + direction[0], y + direction[1])) {
+                ret |= getSquareMask(getSquare(x, y));
+                x += direction[0];
+                y += direction[1];
+            }
+        }
+
+        return ret;
+    }
+
+    void initSlidingAttacks(const position_t (&directions)[4][2], const bitboard_t (&magics)[NUMBER_OF_SQUARES], SlidingAttacks (&slidingAttacks)[NUMBER_OF_SQUARES], bitboard_t* table)
+    {
+        for(position_t square = 0; square < NUMBER_OF_SQUARES; ++square) {
+            auto& entry = slidingAttacks[square];
+            entry.mask = getRelevantOccupancy(directions, square);
+            entry.magic = magics[square];
+            entry.shift = 64 - getPopulationCount(entry.mask);
+            entry.attacks = table;
+
+            // enumerate every subset of the mask, and store its attacks on the magic index
+            std::size_t size = 0;
+            bitboard_t occupancy = EMPTY_BITBOARD;
+            do {
+                auto attacks = getSlidingAttacks(directions, square, occupancy);
+                auto index = (occupancy * entry.magic) >> entry.shift;
+                assert(!table[index] || table[index] == attacks); // the magic number is wrong
+                table[index] = attacks;
+                ++size;
+                occupancy = (occupancy - entry.mask) & entry.mask;
+            } while(occupancy);
+
+            table += size;
+        }
+    }
+
+    struct AttackTablesInitializer
+    {
+        AttackTablesInitializer()
+        {
+            initSlidingAttacks(BISHOP_DIRECTIONS, BISHOP_MAGICS, BISHOP_ATTACKS, BISHOP_TABLE);
+            initSlidingAttacks(ROOK_DIRECTIONS, ROOK_MAGICS, ROOK_ATTACKS, ROOK_TABLE);
+        }
+    };
+
+    const AttackTablesInitializer ATTACK_TABLES_INITIALIZER;
+}
+
+    constexpr square_table_type KNIGHT_ATTACKS = generateLeaperAttacks(KNIGHT_OFFSETS);
+    constexpr square_table_type KING_ATTACKS = generateLeaperAttacks(KING_OFFSETS);
+    constexpr square_table_type PAWN_ATTACKS[2] = { generateLeaperAttacks(PAWN_DOWN_OFFSETS), generateLeaperAttacks(PAWN_UP_OFFSETS) };
+    constexpr square_pair_table_type BETWEEN_SQUARES = generateSquarePairs(false);
+    constexpr square_pair_table_type LINE_SQUARES = generateSquarePairs(true);
+    constexpr distance_table_type DISTANCES = generateDistances();
+}
+}
@@ -0,0 +1,121 @@
+/**********
+ *
+ *     This program is free software: you can redistribute it and/or modify
+ *     it under the terms of the GNU General Public License as published by
+ *     the Free Software Foundation, either version 3 of the License, or
+ *     (at your option) any later version.
+ * 
+ *     This program is distributed in the hope that it will be useful,
+ *     but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *     MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *     GNU General Public License for more details.
+ * 
+ *     You should have received a copy of the GNU General Public License
+ *     along with this program.  If not, see <https://www.gnu.org/licenses/>. 
+ *
+ **********/
+#pragma once
+
+// headers
+#include <array>
+#include "../types.h"
+#include "bitboard.h"
+#include "board.h"
+
+namespace cchess
+{
+namespace detail
+{
+    struct SlidingAttacks
+    {
+        bitboard_t          mask;
+        bitboard_t          magic;
+        const bitboard_t*   attacks;
+        unsigned int        shift;
+
+        bitboard_t getAttacks(bitboard_t occupancy) const { return attacks[((occupancy & mask) * magic) >> shift]; }
+    };
+
+    using square_table_type = std::array<bitboard_t, NUMBER_OF_SQUARES>;
+    using square_pair_table_type = std::array<square_table_type, NUMBER_OF_SQUARES>;
+    using distance_table_type = std::array<std::array<unsigned char, NUMBER_OF_SQUARES>, NUMBER_OF_SQUARES>;
+
+    extern SlidingAttacks BISHOP_ATTACKS[NUMBER_OF_SQUARES];
+    extern SlidingAttacks ROOK_ATTACKS[NUMBER_OF_SQUARES];
+
+    // generated at compile time
+    extern const square_table_type KNIGHT_ATTACKS;
+    extern const square_table_type KING_ATTACKS;
+    extern const square_table_type PAWN_ATTACKS[2];
+    extern const square_pair_table_type BETWEEN_SQUARES;
+    extern const square_pair_table_type LINE_SQUARES;
+    extern const distance_table_type DISTANCES;
+}
+    inline bitboard_t getKnightAttacks(position_t square)
+    {
+        return detail::KNIGHT_ATTACKS[square];
+    }
+
+    inline bitboard_t getKingAttacks(position_t square)
+    {
+        return detail::KING_ATTACKS[square];
+    }
+
+    // squares attacked by a pawn that moves in the given direction (-1 or 1 on the y axis)
+    inline bitboard_t getPawnAttacks(position_t square, position_t pawnDirection)
+    {
+        return detail::PAWN_ATTACKS[pawnDirection > 0][square];
+    }
+
+    // sliding piece attacks, looked up from the magic bitboard tables.
+    // the tables are built once when the program starts
+    inline bitboard_t getBishopAttacks(position_t square, bitboard_t occupancy)
+    {
+        return detail::BISHOP_ATTACKS[square].getAttacks(occupancy);
+    }
+
+    inline bitboard_t getRookAttacks(position_t square, bitboard_t occupancy)
+    {
+        return detail::ROOK_ATTACKS[square].getAttacks(occupancy);
+    }
+
+    inline bitboard_t getQueenAttacks(position_t square, bitboard_t occupancy)
+    {
+        return getBishopAttacks(square, occupancy) | getRookAttacks(square, occupancy);
+    }
+
+    // squares strictly between two squares on the same rank, file or diagonal, empty otherwise
+    inline bitboard_t getBetweenSquares(position_t fromSquare, position_t toSquare)
+    {
+        return detail::BETWEEN_SQUARES[fromSquare][toSquare];
+    }
+
+    // the whole rank, file or diagonal going through both squares, empty if they are not aligned
+    inline bitboard_t getLineSquares(position_t fromSquare, position_t toSquare)
+    {
+        return detail::LINE_SQUARES[fromSquare][toSquare];
+    }
+
+    // the number of king moves between two squares on an empty board
+    inline position_t getDistance(position_t fromSquare, position_t toSquare)
+    {
+        return detail::DISTANCES[fromSquare][toSquare];
+    }
+
+    // the pieces of both colors on the occupancy that attack the square.
+    // look from the square as every piece type, whatever it reaches of the same type attacks it back.
+    // a pawn attacks the square from where a pawn on the square, going the other way, would attack
+    inline bitboard_t getAttackersTo(const Board& board, position_t square, bitboard_t occupancy, position_t whitePawnDirection)
+    {
+        const auto queens = board.getPieces(Piece::Type::QUEEN);
+        auto attackers = (getPawnAttacks(square, -whitePawnDirection) & board.getPieces(Piece::eColor::white, Piece::Type::PAWN)) |
+                         (getPawnAttacks(square, whitePawnDirection) & board.getPieces(Piece::eColor::black, Piece::Type::PAWN)) |
+                         (getKnightAttacks(square) & board.getPieces(Piece::Type::KNIGHT)) |
+                         (getKingAttacks(square) & board.getPieces(Piece::Type::KING)) |
+                         (getBishopAttacks(square, occupancy) & (board.getPieces(Piece::Type::BISHOP) | queens)) |
+                         (getRookAttacks(square, occupancy) & (board.getPieces(Piece::Type::ROOK) | queens));
+
+        // a piece that is not on the occupancy has been captured, and no longer attacks
+        return attackers & occupancy;
+    }
+}
@@ -0,0 +1,73 @@
+/**********
+ *
+ *     This program is free software: you can redistribute it and/or modify
+ *     it under the terms of the GNU General Public License as published by
+ *     the Free Software Foundation, either version 3 of the License, or
+ *     (at your option) any later version.
+ * 
+ *     This program is distributed in the hope that it will be useful,
+ *     but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *     MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *     GNU General Public License for more details.
+ * 
+ *     You should have received a copy of the GNU General Public License
+ *     along with this program.  If not, see <https://www.gnu.org/licenses/>. 
+ *
+ **********/
+#pragma once
+
+// headers
+#include "../define.h"
+#include "../types.h"
+
+namespace cchess
+{
+    // a bitboard stores one bit per square, where the bit index is
+    // the same as the index given by convert2Dto1DPosition (x * BOARD_WIDTH + y)
+    static constexpr bitboard_t EMPTY_BITBOARD = 0;
+    static constexpr position_t NUMBER_OF_SQUARES = BOARD_WIDTH * BOARD_HEIGHT;
+
+    inline constexpr position_t getSquare(position_t x, position_t y)
+    {
+        return x * static_cast<position_t>(BOARD_WIDTH) + y;
+    }
+
+    inline constexpr position_t getSquareX(position_t square)
+    {
+        return square / static_cast<position_t>(BOARD_WIDTH);
+    }
+
+    inline constexpr position_t getSquareY(position_t square)
+    {
+        return square % static_cast<position_t>(BOARD_WIDTH);
+    }
+
+    inline constexpr bool isSquareValid(position_t x, position_t y)
+    {
+        return x >= 0 && x < static_cast<position_t>(BOARD_WIDTH) &&
+               y >= 0 && y < static_cast<position_t>(BOARD_HEIGHT);
+    }
+
+    inline constexpr bitboard_t getSquareMask(position_t square)
+    {
+        return bitboard_t(1) << square;
+    }
+
+    inline int getPopulationCount(bitboard_t bitboard)
+    {
+        return __builtin_popcountll(bitboard);
+    }
+
+    inline position_t getFirstSquare(bitboard_t bitboard)
+    {
+        return static_cast<position_t>(__builtin_ctzll(bitboard));
+    }
+
+    inline position_t popFirstSquare(bitboard_t& bitboard)
+    {
+        auto square = getFirstSquare(bitboard);
+        bitboard &= bitboard - 1;
+
+        return square;
+    }
+}
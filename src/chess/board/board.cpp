@@ -0,0 +1,74 @@
+/**********
+ *
+ *     This program is free software: you can redistribute it and/or modify
+ *     it under the terms of the GNU General Public License as published by
+ *     the Free Software Foundation, either version 3 of the License, or
+ *     (at your option) any later version.
+ * 
+ *     This program is distributed in the hope that it will be useful,
+ *     but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *     MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *     GNU General Public License for more details.
+ * 
+ *     You should have received a copy of the GNU General Public License
+ *     along with this program.  If not, see <https://www.gnu.org/licenses/>. 
+ *
+ **********/
+// headers
+#include <assert.h>
+#include "board.h"
+
+namespace cchess
+{
+    Board::Board() :
+        m_mailbox(Piece())
+    {
+        clear();
+    }
+
+    void Board::clear()
+    {
+        for(auto& piece : m_mailbox)
+            piece = Piece();
+
+        for(auto& pieces : m_pieces)
+            pieces = EMPTY_BITBOARD;
+        m_colors[0] = EMPTY_BITBOARD;
+        m_colors[1] = EMPTY_BITBOARD;
+    }
+
+    void Board::setPiece(position_t square, Piece piece)
+    {
+        assert(square >= 0 && square < NUMBER_OF_SQUARES);
+
+        // remove what was on the square first
+        auto& squarePiece = m_mailbox[square];
+        if(!squarePiece.isEmpty())
+            togglePiece(square, squarePiece);
+
+        squarePiece = piece;
+        if(!piece.isEmpty())
+            togglePiece(square, piece);
+    }
+
+    Piece Board::removePiece(position_t square)
+    {
+        assert(square >= 0 && square < NUMBER_OF_SQUARES);
+
+        auto piece = m_mailbox[square];
+        if(!piece.isEmpty()) {
+            togglePiece(square, piece);
+            m_mailbox[square] = Piece();
+        }
+
+        return piece;
+    }
+
+    void Board::togglePiece(position_t square, Piece piece)
+    {
+        auto mask = getSquareMask(square);
+
+        m_pieces[piece.getTypeIndex()] ^= mask;
+        m_colors[getColorIndex(piece.getColor())] ^= mask;
+    }
+}
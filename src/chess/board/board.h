@@ -0,0 +1,63 @@
+/**********
+ *
+ *     This program is free software: you can redistribute it and/or modify
+ *     it under the terms of the GNU General Public License as published by
+ *     the Free Software Foundation, either version 3 of the License, or
+ *     (at your option) any later version.
+ * 
+ *     This program is distributed in the hope that it will be useful,
+ *     but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *     MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *     GNU General Public License for more details.
+ * 
+ *     You should have received a copy of the GNU General Public License
+ *     along with this program.  If not, see <https://www.gnu.org/licenses/>. 
+ *
+ **********/
+#pragma once
+
+// headers
+#include "../3rdparty/container/fixed_sized_array.h"
+#include "../piece/piece.h"
+#include "../define.h"
+#include "../types.h"
+#include "bitboard.h"
+
+namespace cchess
+{
+    // board representation, keeps a piece per square (mailbox) and
+    // an occupancy bitboard for every piece type and every color in sync.
+    // the pieces of a color and type are the intersection of both
+    class Board
+    {
+        using mailbox_container_type = mar::container::fixed_sized_array<Piece, NUMBER_OF_SQUARES, mar::container::inline_storage>;
+
+    public:
+        Board();
+
+        void clear();
+
+        void setPiece(position_t square, Piece piece);
+        Piece removePiece(position_t square);
+
+        Piece getPiece(position_t square) const { return m_mailbox[square]; }
+        bool isEmpty(position_t square) const { return !(getOccupancy() & getSquareMask(square)); }
+
+        bitboard_t getPieces(Piece::eColor color, Piece::Type type) const { return m_pieces[getTypeIndex(type)] & m_colors[getColorIndex(color)]; }
+        bitboard_t getPieces(Piece::eColor color) const { return m_colors[getColorIndex(color)]; }
+        bitboard_t getPieces(Piece::Type type) const { return m_pieces[getTypeIndex(type)]; }
+        bitboard_t getOccupancy() const { return m_colors[0] | m_colors[1]; }
+
+        constexpr std::size_t capacity() const { return NUMBER_OF_SQUARES; }
+
+    private:
+        void togglePiece(position_t square, Piece piece);
+
+        // a byte per square, so the whole mailbox is one cache line
+        alignas(CACHE_LINE_SIZE) mailbox_container_type  m_mailbox;
+        bitboard_t                                      m_pieces[Piece::NUMBER_OF_TYPE];
+        bitboard_t                                      m_colors[Piece::NUMBER_OF_COLOR];
+    };
+
+    static_assert(sizeof(Board) == 2 * CACHE_LINE_SIZE, "the mailbox and the bitboards must each fit in a cache line");
+}
@@ -15,8 +15,12 @@
  *
  **********/
 // headers
-#include <unordered_map>
+#include <charconv>
+#include <cmath>
+#include "board/attacks.h"
 #include "debug/debug_log.h"
+#include "move/moveGenerator.h"
+#include "move/moveLegality.h"
 #include "piece/piecesCaptureMoveset.h"
 #include "piece/piecesMoveset.h"
 #include "chess.h"
@@ -24,7 +28,6 @@
 namespace cchess
 {
     Chess::Chess() :
-        m_boardStateManager(*this),
         m_hasTurnClock(false)
     {
         resetBoard(Piece::eColor::white);
@@ -38,7 +41,7 @@ namespace cchess
                 return;
             }
 
-            auto colorTurn = getColorIndex(m_currentColorsTurn);
+            auto colorTurn = getColorIndex(m_position.sideToMove);
             auto& turnClock = m_turnClock[colorTurn];
             auto elapsed = turnClock.get_elapsed().as_seconds();
 
@@ -53,10 +56,14 @@ namespace cchess
 
     void Chess::resetBoard(Piece::eColor color, bool hasTurnClock, bool disableOppositeColorHint)
     {
-        m_board = board_container_type(Piece());
-        m_bottomColor = color;
-        m_currentColorsTurn = Piece::eColor::white;
+        m_position.board.clear();
+        m_position.bottomColor = color;
+        m_position.sideToMove = Piece::eColor::white;
+        m_position.halfmoveClock = 0;
+        m_position.fullmoveNumber = 1;
+        m_position.castlingRights = ALL_CASTLING_RIGHTS;
         m_disableOppositeColorHint = disableOppositeColorHint;
+        m_isWaitingForPromotion = false;
 
         m_hasTurnClock = hasTurnClock;
         m_turnClockTimeLeft[getColorIndex(Piece::eColor::white)] = 5 * 60;
@@ -74,13 +81,296 @@ namespace cchess
         initPieces(Piece::eColor::white);
         initPieces(Piece::eColor::black);
 
-        m_enPassant[whiteColorIndex] = Position(-1, -1);
-        m_enPassant[blackColorIndex] = Position(-1, -1);
+        m_position.enPassant[whiteColorIndex] = NO_SQUARE;
+        m_position.enPassant[blackColorIndex] = NO_SQUARE;
 
         m_boardStateManager.resetStates(*this);
         m_boardHistoryManager.resetHistory();
     }
 
+    void Chess::setPositionState(const PositionState& position)
+    {
+        m_position = position;
+        m_isWaitingForPromotion = false;
+        resetAlivePieces();
+
+        // the captured pieces belong to the game the position came from
+        m_deadPieces[getColorIndex(Piece::eColor::white)].clear();
+        m_deadPieces[getColorIndex(Piece::eColor::black)].clear();
+
+        m_boardStateManager.resetStates(*this);
+        m_boardHistoryManager.resetHistory();
+    }
+
+namespace
+{
+    static constexpr position_t FEN_NUMBER_OF_ROWS = BOARD_HEIGHT;
+    static constexpr position_t FEN_NUMBER_OF_FILES = BOARD_WIDTH;
+    static constexpr position_t FEN_KING_FILE = 4;
+    static constexpr position_t FEN_KINGSIDE_ROOK_FILE = FEN_NUMBER_OF_FILES - 1;
+    static constexpr position_t FEN_QUEENSIDE_ROOK_FILE = 0;
+
+    // enough for any position and its move counters, so a FEN is allocated once
+    static constexpr std::size_t MAX_FEN_LENGTH = 92;
+
+    // a FEN goes from a8 to h1, while the board is laid out from its bottom color's side.
+    // turning the board around is its own inverse, so this also goes from the board to the FEN
+    Chess::Position getBoardPosition(position_t file, position_t row, Piece::eColor bottomColor)
+    {
+        if(bottomColor == Piece::eColor::white)
+            return Chess::Position(file, row);
+
+        return Chess::Position(FEN_NUMBER_OF_FILES - 1 - file, FEN_NUMBER_OF_ROWS - 1 - row);
+    }
+
+    position_t getFENBackRow(Piece::eColor color)
+    {
+        return color == Piece::eColor::white ? FEN_NUMBER_OF_ROWS - 1 : 0;
+    }
+
+    // moves the view past the next space separated field, and returns it
+    std::string_view popFENField(std::string_view& fen)
+    {
+        auto start = fen.find_first_not_of(' ');
+        if(start == std::string_view::npos) {
+            fen = std::string_view();
+            return fen;
+        }
+
+        auto end = fen.find(' ', start);
+        auto field = fen.substr(start, end - start);
+        fen = end == std::string_view::npos ? std::string_view() : fen.substr(end);
+
+        return field;
+    }
+
+    bool parseFENCounter(std::string_view field, unsigned int& counter)
+    {
+        auto result = std::from_chars(field.data(), field.data() + field.size(), counter);
+        return result.ec == std::errc() && result.ptr == field.data() + field.size();
+    }
+
+    void appendFENCounter(std::string& fen, unsigned int counter)
+    {
+        char buffer[16];
+        auto result = std::to_chars(buffer, buffer + sizeof(buffer), counter);
+        fen.append(buffer, result.ptr);
+    }
+}
+    bool Chess::setFromFEN(std::string_view fen)
+    {
+        // the position is built aside, the game only changes once the whole FEN is valid
+        PositionState position;
+        position.board.clear();
+        position.bottomColor = m_position.bottomColor;
+        position.halfmoveClock = 0;
+        position.fullmoveNumber = 1;
+        position.castlingRights = NO_CASTLING_RIGHTS;
+        position.enPassant[getColorIndex(Piece::eColor::white)] = NO_SQUARE;
+        position.enPassant[getColorIndex(Piece::eColor::black)] = NO_SQUARE;
+
+        // piece placement, from the 8th rank to the 1st
+        position_t file = 0;
+        position_t row = 0;
+        for(auto character : popFENField(fen)) {
+            if(character == '/') {
+                if(file != FEN_NUMBER_OF_FILES || ++row >= FEN_NUMBER_OF_ROWS)
+                    return false;
+                file = 0;
+            } else if(character >= '1' && character <= '8') {
+                file += character - '0';
+                if(file > FEN_NUMBER_OF_FILES)
+                    return false;
+            } else {
+                auto type = getTypeOfCharacter(character);
+                if(type == Piece::Type::EMPTY || file >= FEN_NUMBER_OF_FILES)
+                    return false;
+
+                // a pawn on the last rank would have been promoted
+                if(type == Piece::Type::PAWN && (row == 0 || row == FEN_NUMBER_OF_ROWS - 1))
+                    return false;
+
+                auto color = std::isupper(static_cast<unsigned char>(character)) ? Piece::eColor::white : Piece::eColor::black;
+                auto boardPosition = getBoardPosition(file, row, position.bottomColor);
+                position.board.setPiece(getSquare(boardPosition.x, boardPosition.y), Piece(type, color));
+                ++file;
+            }
+        }
+
+        if(row != FEN_NUMBER_OF_ROWS - 1 || file != FEN_NUMBER_OF_FILES)
+            return false;
+        // a king for each color, and no more pieces than a color starts with
+        for(auto color : { Piece::eColor::white, Piece::eColor::black }) {
+            if(getPopulationCount(position.board.getPieces(color, Piece::Type::KING)) != 1 ||
+               getPopulationCount(position.board.getPieces(color)) > static_cast<int>(MAX_PIECES_PER_COLOR))
+                return false;
+        }
+
+        // side to move
+        auto sideToMove = popFENField(fen);
+        if(sideToMove == "w")
+            position.sideToMove = Piece::eColor::white;
+        else if(sideToMove == "b")
+            position.sideToMove = Piece::eColor::black;
+        else
+            return false;
+
+        // castling rights, a right whose king or rook is not on its square anymore is dropped
+        auto castling = popFENField(fen);
+        if(castling.empty())
+            return false;
+        if(castling != "-") {
+            for(auto character : castling) {
+                auto color = std::isupper(static_cast<unsigned char>(character)) ? Piece::eColor::white : Piece::eColor::black;
+                auto type = getTypeOfCharacter(character);
+                if(type != Piece::Type::KING && type != Piece::Type::QUEEN)
+                    return false;
+
+                auto backRow = getFENBackRow(color);
+                auto rookFile = type == Piece::Type::KING ? FEN_KINGSIDE_ROOK_FILE : FEN_QUEENSIDE_ROOK_FILE;
+                auto kingPosition = getBoardPosition(FEN_KING_FILE, backRow, position.bottomColor);
+                auto rookPosition = getBoardPosition(rookFile, backRow, position.bottomColor);
+                if(position.board.getPiece(getSquare(kingPosition.x, kingPosition.y)) == Piece(Piece::Type::KING, color) &&
+                   position.board.getPiece(getSquare(rookPosition.x, rookPosition.y)) == Piece(Piece::Type::ROOK, color))
+                    position.castlingRights |= getCastlingRight(color, rookPosition.x);
+            }
+        }
+
+        // en passant target square, right behind the pawn that just moved two squares
+        auto enPassant = popFENField(fen);
+        if(enPassant.empty())
+            return false;
+        if(enPassant != "-") {
+            const auto movedColor = getOppositeColor(position.sideToMove);
+            const position_t targetRow = movedColor == Piece::eColor::white ? 5 : 2;
+            if(enPassant.size() != 2 || enPassant[0] < 'a' || enPassant[0] > 'h' || '8' - enPassant[1] != targetRow)
+                return false;
+
+            const position_t enPassantFile = enPassant[0] - 'a';
+            const position_t pawnRow = targetRow + (movedColor == Piece::eColor::white ? -1 : 1);
+            const position_t startRow = targetRow + (movedColor == Piece::eColor::white ? 1 : -1);
+            auto pawnPosition = getBoardPosition(enPassantFile, pawnRow, position.bottomColor);
+            auto targetPosition = getBoardPosition(enPassantFile, targetRow, position.bottomColor);
+            auto startPosition = getBoardPosition(enPassantFile, startRow, position.bottomColor);
+            if(position.board.getPiece(getSquare(pawnPosition.x, pawnPosition.y)) != Piece(Piece::Type::PAWN, movedColor) ||
+               !position.board.isEmpty(getSquare(targetPosition.x, targetPosition.y)) ||
+               !position.board.isEmpty(getSquare(startPosition.x, startPosition.y)))
+                return false;
+
+            position.enPassant[getColorIndex(movedColor)] = static_cast<std::int8_t>(getSquare(pawnPosition.x, pawnPosition.y));
+        }
+
+        // the move counters are often left out
+        auto halfmoveClock = popFENField(fen);
+        if(!halfmoveClock.empty() && !parseFENCounter(halfmoveClock, position.halfmoveClock))
+            return false;
+
+        auto fullmoveNumber = popFENField(fen);
+        if(!fullmoveNumber.empty() && (!parseFENCounter(fullmoveNumber, position.fullmoveNumber) || !position.fullmoveNumber))
+            return false;
+
+        if(!popFENField(fen).empty())
+            return false;
+
+        // the side that just moved can't have left its king on check
+        std::swap(m_position, position);
+        const auto isKingLeftOnCheck = isOnCheck(getOppositeColor(m_position.sideToMove));
+        std::swap(m_position, position);
+        if(isKingLeftOnCheck)
+            return false;
+
+        setPositionState(position);
+
+        // the missing pieces are the captured ones, the pieces above the starting count are promoted pawns
+        static constexpr unsigned int STARTING_PIECES[Piece::NUMBER_OF_TYPE] = { 8, 2, 2, 2, 1, 1 };
+        for(auto color : { Piece::eColor::white, Piece::eColor::black }) {
+            unsigned int numberOfPieces[Piece::NUMBER_OF_TYPE] = {};
+            for(const auto& pieceInformation : getAlivePieces(color))
+                ++numberOfPieces[pieceInformation.getPiece().getTypeIndex()];
+
+            unsigned int numberOfPromotions = 0;
+            for(std::size_t typeIndex = getTypeIndex(Piece::Type::KNIGHT); typeIndex <= getTypeIndex(Piece::Type::QUEEN); ++typeIndex) {
+                if(numberOfPieces[typeIndex] > STARTING_PIECES[typeIndex])
+                    numberOfPromotions += numberOfPieces[typeIndex] - STARTING_PIECES[typeIndex];
+            }
+            numberOfPieces[getTypeIndex(Piece::Type::PAWN)] += numberOfPromotions;
+
+            auto& deadPieces = m_deadPieces[getColorIndex(color)];
+            for(auto type : { Piece::Type::PAWN, Piece::Type::KNIGHT, Piece::Type::BISHOP, Piece::Type::ROOK, Piece::Type::QUEEN }) {
+                auto typeIndex = getTypeIndex(type);
+                for(auto i = numberOfPieces[typeIndex]; i < STARTING_PIECES[typeIndex]; ++i)
+                    deadPieces.emplace_back(Piece(type, color), -1, -1);
+            }
+        }
+
+        return true;
+    }
+
+    std::string Chess::toFEN() const
+    {
+        std::string ret;
+        ret.reserve(MAX_FEN_LENGTH);
+
+        for(position_t row = 0; row < FEN_NUMBER_OF_ROWS; ++row) {
+            char numberOfEmptySquares = 0;
+            for(position_t file = 0; file < FEN_NUMBER_OF_FILES; ++file) {
+                auto boardPosition = getBoardPosition(file, row, m_position.bottomColor);
+                auto piece = getBoardPiece(boardPosition.x, boardPosition.y);
+                if(piece.isEmpty()) {
+                    ++numberOfEmptySquares;
+                    continue;
+                }
+
+                if(numberOfEmptySquares) {
+                    ret += static_cast<char>('0' + numberOfEmptySquares);
+                    numberOfEmptySquares = 0;
+                }
+                ret += piece.getColor() == Piece::eColor::white ?
+                            static_cast<char>(toupper(getCharacterOfPiece(piece))) :
+                            static_cast<char>(tolower(getCharacterOfPiece(piece)));
+            }
+
+            if(numberOfEmptySquares)
+                ret += static_cast<char>('0' + numberOfEmptySquares);
+            if(row < FEN_NUMBER_OF_ROWS - 1)
+                ret += '/';
+        }
+
+        ret += m_position.sideToMove == Piece::eColor::white ? " w " : " b ";
+
+        if(!m_position.castlingRights) {
+            ret += '-';
+        } else {
+            for(auto color : { Piece::eColor::white, Piece::eColor::black }) {
+                auto isWhite = color == Piece::eColor::white;
+                if(canCastle(color, getBoardPosition(FEN_KINGSIDE_ROOK_FILE, 0, m_position.bottomColor).x))
+                    ret += isWhite ? 'K' : 'k';
+                if(canCastle(color, getBoardPosition(FEN_QUEENSIDE_ROOK_FILE, 0, m_position.bottomColor).x))
+                    ret += isWhite ? 'Q' : 'q';
+            }
+        }
+
+        // the square the pawn that just moved two squares went over
+        const auto movedColor = getOppositeColor(m_position.sideToMove);
+        const auto& enPassantPosition = getEnPassantPosition(movedColor);
+        ret += ' ';
+        if(enPassantPosition.x >= 0) {
+            auto pawnPosition = getBoardPosition(enPassantPosition.x, enPassantPosition.y, m_position.bottomColor);
+            auto targetRow = pawnPosition.y + (movedColor == Piece::eColor::white ? 1 : -1);
+            ret += static_cast<char>('a' + pawnPosition.x);
+            ret += static_cast<char>('8' - targetRow);
+        } else {
+            ret += '-';
+        }
+
+        ret += ' ';
+        appendFENCounter(ret, m_position.halfmoveClock);
+        ret += ' ';
+        appendFENCounter(ret, m_position.fullmoveNumber);
+
+        return ret;
+    }
+
     int Chess::getTimeLeft(Piece::eColor color)
     {
         return m_turnClockTimeLeft[getColorIndex(color)];
@@ -88,7 +378,7 @@ namespace cchess
 
     void Chess::resetTimer()
     {
-        m_turnClock[getColorIndex(m_currentColorsTurn)].restart();
+        m_turnClock[getColorIndex(m_position.sideToMove)].restart();
     }
 
     Chess::select_piece_return_type Chess::selectPiece(position_t x, position_t y) const
@@ -96,17 +386,15 @@ namespace cchess
         auto piece = getBoardPiece(x, y);
         if(!piece.isEmpty()) {
             if(m_disableOppositeColorHint) {
-                if(piece.getColor() == m_currentColorsTurn) {
-                    std::vector<Position> ret = getValidMoves(piece, x, y);
-                    return select_piece_return_type(PieceInformation(piece, x, y), ret);
+                if(piece.getColor() == m_position.sideToMove) {
+                    return select_piece_return_type(PieceInformation(piece, x, y), getValidMoves(piece, x, y));
                 }
             } else {
-                std::vector<Position> ret = getValidMoves(piece, x, y);
-                return select_piece_return_type(PieceInformation(piece, x, y), ret);
+                return select_piece_return_type(PieceInformation(piece, x, y), getValidMoves(piece, x, y));
             }
         }
 
-        return select_piece_return_type(PieceInformation(), std::vector<Position>());
+        return select_piece_return_type(PieceInformation(), valid_moves_container_type());
     }
 
     Chess::select_piece_return_type Chess::selectPiece(const std::string& pos) const
@@ -117,74 +405,28 @@ namespace cchess
         if(x >= 0 && y >= 0)
             return selectPiece(x, y);
 
-        return std::make_pair(PieceInformation(), std::vector<Position>());
+        return select_piece_return_type(PieceInformation(), valid_moves_container_type());
     }
 
     Chess::EMoveResult Chess::move(position_t xs, position_t ys, position_t xd, position_t yd)
     {
+        // can only move if there is no promotion waiting
         if(!isWaitingForPromotion()) {
-            // can only move if there is no promotion waiting
-            const auto fromPos = convert2Dto1DPosition(xs, ys, BOARD_WIDTH);
-            const auto toPos = convert2Dto1DPosition(xd, yd, BOARD_WIDTH);
-            if(isPositionValid(fromPos) && isPositionValid(toPos) && (xs != xd || ys != yd)) {
-                const auto fromPiece = m_board[fromPos];
-                const auto toPiece = m_board[toPos];
-
-                if(!fromPiece.isEmpty() && fromPiece.getColor() == m_currentColorsTurn) {
-                    const auto fromColor = fromPiece.getColor();
-                    const auto fromColorIndex = getColorIndex(fromColor);
-                    const auto& lastEnPassantPosition = m_enPassant[fromColorIndex];
-
-                    if(toPiece.isEmpty()) {
-                        if(fromPiece.getType() == Piece::Type::PAWN) {
-                            if(movePawn(fromPiece, fromColor, fromColorIndex, xs, ys, xd, yd))
-                                return EMoveResult::Move;
-                        } else {
-                            const auto moves = isMoveValid(fromPiece, xs, ys, xd, yd, *this);
-                            if(tryMove(moves)) {
-                                for(const auto& t : moves) {
-                                    auto tp = std::get<0>(t);
-                                    auto txs = std::get<1>(t);
-                                    auto tys = std::get<2>(t);
-                                    auto txd = std::get<3>(t);
-                                    auto tyd = std::get<4>(t);
-                                    m_boardStateManager.updateStateOnMove(tp, txs, tys, txd, tyd);
-                                }
-                                m_boardHistoryManager.addMoveToHistory(moves);
-                                m_boardHistoryManager.addLastEnPassant(fromColor, lastEnPassantPosition.x, lastEnPassantPosition.y);
-                                m_enPassant[fromColorIndex] = Position(-1, -1);
-                                m_currentColorsTurn = getOppositeColor(m_currentColorsTurn);
-                                return EMoveResult::Move;
-                            }
-                        }
-                    } else {
-                        const auto toColor = toPiece.getColor();
-                        const auto toColorIndex = getColorIndex(toColor);
-
-                        if(fromColor != toColor) {
-                            const auto captures = isCaptureValid(fromPiece, xs, ys, xd, yd, *this);
-                            if(std::get<0>(captures)) {
-                                auto xc = std::get<1>(captures);
-                                auto yc = std::get<2>(captures);
-                                auto captureResult = tryCapture(fromPiece, xs, ys, xd, yd, xc, yc);
-                                if(captureResult.first) {
-                                    auto pieceCaptured = captureResult.second;
-                                    m_deadPieces[toColorIndex].push_back(PieceInformation(pieceCaptured, xc, yc));
-                                    m_boardStateManager.updateStateOnCapture(fromPiece, pieceCaptured, xs, ys, xd, yd, xc, yc);
-                                    m_boardHistoryManager.addCaptureToHistory(toColor, fromPiece.hasMoved(), xs, ys, xd, yd);
-                                    m_boardHistoryManager.addLastEnPassant(fromColor, lastEnPassantPosition.x, lastEnPassantPosition.y);
-                                    m_enPassant[fromColorIndex] = Position(-1, -1);
-
-                                    if(fromPiece.getType() == Piece::Type::PAWN)
-                                        checkPawnPromotion(xd, yd);
-
-                                    m_currentColorsTurn = getOppositeColor(m_currentColorsTurn);
-                                    return EMoveResult::Capture;
-                                }
-                            }
-                        }
-                    }
+            auto move = findLegalMove(xs, ys, xd, yd);
+            if(!move.isEmpty()) {
+                const auto fromPiece = getBoardPiece(xs, ys);
+                auto capturedPiece = makeMove(move, true);
+
+                // the captured pieces are only kept for the game, the lean doMove doesn't track them
+                if(!capturedPiece.isEmpty()) {
+                    const auto capturedSquare = getCapturedSquare(move);
+                    m_deadPieces[getColorIndex(capturedPiece.getColor())].emplace_back(capturedPiece, getSquareX(capturedSquare), getSquareY(capturedSquare));
                 }
+
+                if(fromPiece.getType() == Piece::Type::PAWN)
+                    checkPawnPromotion(xd, yd);
+
+                return capturedPiece.isEmpty() ? EMoveResult::Move : EMoveResult::Capture;
             }
         }
 
@@ -214,16 +456,49 @@ namespace cchess
         return EMoveResult::Invalid;
     }
 
+    Chess::EMoveResult Chess::move(Move move)
+    {
+        auto fromSquare = move.getFrom();
+        auto toSquare = move.getTo();
+        auto ret = this->move(getSquareX(fromSquare), getSquareY(fromSquare), getSquareX(toSquare), getSquareY(toSquare));
+
+        // promote right away, since the move already knows the type
+        if(ret != EMoveResult::Invalid && move.getFlag() == Move::eFlag::Promotion)
+            setTypeToPromoteTo(move.getTypeToPromoteTo());
+
+        return ret;
+    }
+
+    bool Chess::isMoveLegal(Move move) const
+    {
+        if(move.isEmpty() || isWaitingForPromotion())
+            return false;
+
+        auto fromSquare = move.getFrom();
+        auto toSquare = move.getTo();
+        auto legalMove = findLegalMove(getSquareX(fromSquare), getSquareY(fromSquare), getSquareX(toSquare), getSquareY(toSquare));
+        if(legalMove.isEmpty())
+            return false;
+
+        // the rules leave the promotion to the player, a pawn reaching the last rank has to promote
+        auto flag = legalMove.getFlag();
+        auto yd = getSquareY(toSquare);
+        if(m_position.board.getPiece(fromSquare).getType() == Piece::Type::PAWN && (yd == RANK_1 || yd == RANK_8))
+            return flag == Move::eFlag::Normal && move == Move(fromSquare, toSquare, Move::eFlag::Promotion, move.getTypeToPromoteTo());
+
+        return move == legalMove;
+    }
+
     bool Chess::undo()
     {
-        assert((m_boardStateManager.isThereStateToUndo() && m_boardHistoryManager.isThereHistoryToUndo()) ||
-               (!m_boardStateManager.isThereStateToUndo() && !m_boardHistoryManager.isThereHistoryToUndo()));
         if(!isWaitingForPromotion()) {
-            if(m_boardStateManager.isThereStateToUndo() && m_boardHistoryManager.isThereHistoryToUndo()) {
-                m_boardStateManager.undoLastState();
-                m_boardHistoryManager.undoLastMove(*this);
-                m_currentColorsTurn = getOppositeColor(m_currentColorsTurn);
+            if(m_boardHistoryManager.isThereHistoryToUndo()) {
+                // only the moves of the game went to the captured pieces
+                const auto& record = m_boardHistoryManager.getLastRecord();
+                if(record.isStateRecorded && !record.capturedPiece.isEmpty())
+                    m_deadPieces[getColorIndex(record.capturedPiece.getColor())].pop_back();
 
+                undoLastRecord();
                 return true;
             }
         }
@@ -231,46 +506,54 @@ namespace cchess
         return false;
     }
 
+    void Chess::doMove(Move move)
+    {
+        assert(!isWaitingForPromotion());
+        assert(!move.isEmpty() && m_position.board.getPiece(move.getFrom()).getColor() == m_position.sideToMove);
+
+        makeMove(move, false);
+    }
+
+    void Chess::undoMove()
+    {
+        assert(m_boardHistoryManager.isThereHistoryToUndo());
+        assert(!m_boardHistoryManager.getLastRecord().isStateRecorded);
+
+        undoLastRecord();
+    }
+
     bool Chess::isOnCheck(Piece::eColor color) const
     {
-        const auto& kingInformation = getKing(color);
-        const auto& kingPosition = kingInformation.getPosition();
-        return isCheck(kingInformation, kingPosition.x, kingPosition.y, *this).size();
+        return isSquareAttacked(getKingSquare(color), getOppositeColor(color));
+    }
+
+    bitboard_t Chess::getAttackersTo(position_t square, bitboard_t occupancy) const
+    {
+        return cchess::getAttackersTo(m_position.board, square, occupancy, getPawnDirection(Piece::eColor::white));
+    }
+
+    bool Chess::isSquareAttacked(position_t square, Piece::eColor color) const
+    {
+        return getAttackersTo(square, m_position.board.getOccupancy()) & m_position.board.getPieces(color);
     }
 
     bool Chess::isCheckMate(Piece::eColor color) const
     {
         // a checkmate occurs when the player's king is on check,
         // and the player's pieces have no valid moves
-        if(isOnCheck(color)) {
-            for(const auto& pieceInformation : getAlivePieces(color)) {
-                const auto& piecePosition = pieceInformation.getPosition();
-                if(getValidMoves(pieceInformation.getPiece(), piecePosition.x, piecePosition.y).size())
-                    return false;
-            }
-            const auto& king = getKing(color);
-            const auto& kingPosition = king.getPosition();
-            if(getValidMoves(king.getPiece(), kingPosition.x, kingPosition.y).size())
-                return false;
-
-            return true;
-        }
-
-        return false;
+        return isOnCheck(color) && !hasAnyLegalMove(color);
     }
 
     bool Chess::isStaleMate(Piece::eColor color) const
     {
-        // stalemate occurs when the player only has a king left, and player's king is not on check
-        // but the player's king have 0 available move
-        if(!isOnCheck(color) && !getAlivePieces(color).size()) {
-            const auto& king = getKing(color);
-            const auto& kingPosition = king.getPosition();
-            if(!getValidMoves(king.getPiece(), kingPosition.x, kingPosition.y).size())
-                return true;
-        }
+        // stalemate occurs when the player's king is not on check,
+        // but the player's pieces have no valid moves
+        return !isOnCheck(color) && !hasAnyLegalMove(color);
+    }
 
-        return false;
+    bool Chess::hasAnyLegalMove(Piece::eColor color) const
+    {
+        return cchess::hasAnyLegalMove(color, *this);
     }
 
     void Chess::setTypeToPromoteTo(Piece::Type type)
@@ -279,32 +562,40 @@ namespace cchess
             const auto& promotionPosition = m_positionForPromotion;
             auto promPos = convert2Dto1DPosition(promotionPosition.x, promotionPosition.y, BOARD_WIDTH);
             // set the pieces
-            auto pieceToPromoteFrom = m_board[promPos];
-            auto pieceToPromoteTo = Piece(type, 9, m_colorWaitingForPromotion); // TODO: add ids for promotable types
-
-            // find the piece from alive pieces, and update it's piece information
-            for(auto& pieceInformation : m_alivePieces[getColorIndex(m_colorWaitingForPromotion)]) {
-                if(pieceInformation.getPiece() == pieceToPromoteFrom) {
-                    pieceInformation.m_piece = pieceToPromoteTo;
-                }
-            }
+            auto pieceToPromoteFrom = m_position.board.getPiece(promPos);
+            auto pieceToPromoteTo = Piece(type, m_colorWaitingForPromotion);
 
             // update the piece to promoted type
-            m_board[promPos] = pieceToPromoteTo;
+            m_position.board.setPiece(promPos, pieceToPromoteTo);
+            updatePieceInformation(m_colorWaitingForPromotion, promPos, pieceToPromoteTo, promPos);
+            m_boardStateManager.updateStateOnPromotion(pieceToPromoteFrom, pieceToPromoteTo, promotionPosition.x, promotionPosition.y);
+
+            // the last move becomes a promotion, so undoing it brings the pawn back
+            auto& record = m_boardHistoryManager.getLastRecord();
+            record.move = Move(record.move.getFrom(), record.move.getTo(), Move::eFlag::Promotion, type);
             m_isWaitingForPromotion = false;
+            assert(m_boardStateManager.isStateValid(*this));
         }
     }
 
     Piece Chess::getBoardPiece(position_t x, position_t y) const
     {
-        auto pos = convert2Dto1DPosition(x, y, BOARD_WIDTH);
-        if(isPositionValid(pos))
-            return m_board[pos];
+        if(isSquareValid(x, y))
+            return m_position.board.getPiece(convert2Dto1DPosition(x, y, BOARD_WIDTH));
 
         return Piece();
     }
 
-    std::vector<Chess::Position> Chess::getValidMoves(position_t x, position_t y) const
+    Chess::Position Chess::getEnPassantPosition(Piece::eColor color) const
+    {
+        const auto square = m_position.enPassant[getColorIndex(color)];
+        if(square == NO_SQUARE)
+            return Position(-1, -1);
+
+        return Position(getSquareX(square), getSquareY(square));
+    }
+
+    Chess::valid_moves_container_type Chess::getValidMoves(position_t x, position_t y) const
     {
         auto piece = getBoardPiece(x, y);
         if(!piece.isEmpty())
@@ -313,6 +604,11 @@ namespace cchess
         return {};
     }
 
+    void Chess::generateLegalMoves(Piece::eColor color, MoveList& moves) const
+    {
+        cchess::generateLegalMoves(color, *this, moves);
+    }
+
     std::string Chess::getBoardString() const
     {
         static const char INT_TO_CHAR[] =
@@ -342,7 +638,7 @@ namespace cchess
 
         for(position_t y = 0; y < iheight; ++y) {
             std::string rankString;
-            if(m_bottomColor == Piece::eColor::white)
+            if(m_position.bottomColor == Piece::eColor::white)
                 rankString = std::to_string((iheight - y));
             else
                 rankString = std::to_string(y + 1);
@@ -384,7 +680,7 @@ namespace cchess
 
     bool Chess::isPositionValid(position_t pos) const
     {
-        return pos >= 0 && pos < static_cast<position_t>(m_board.capacity());
+        return pos >= 0 && pos < static_cast<position_t>(m_position.board.capacity());
     }
 
     void Chess::initPieces(Piece::eColor color)
@@ -394,26 +690,26 @@ namespace cchess
         static const std::pair<position_t, position_t> QUEEN_KING_X_POS[] = { { 3, 4 }, { 4, 3 } };
 
         // determine which pieces are on the bottom
-        std::size_t positionIndex = (color == m_bottomColor ? 0 : 1);
+        std::size_t positionIndex = (color == m_position.bottomColor ? 0 : 1);
 
         auto pawnStartingYPos = PAWN_STARTING_Y_POS[positionIndex];
         for(auto i = 0; i < static_cast<position_t>(BOARD_WIDTH); ++i)
-            addPiece(Piece::Type::PAWN, i, color, i, pawnStartingYPos);
+            addPiece(Piece::Type::PAWN, color, i, pawnStartingYPos);
 
         auto otherStartingYPos = OTHER_STARTING_Y_POS[positionIndex];
-        addPiece(Piece::Type::KNIGHT, 0, color, 1, otherStartingYPos);
-        addPiece(Piece::Type::KNIGHT, 1, color, 6, otherStartingYPos);
-        addPiece(Piece::Type::BISHOP, 0, color, 2, otherStartingYPos);
-        addPiece(Piece::Type::BISHOP, 1, color, 5, otherStartingYPos);
-        addPiece(Piece::Type::ROOK, 0, color, 0, otherStartingYPos);
-        addPiece(Piece::Type::ROOK, 1, color, 7, otherStartingYPos);
-
-        const auto& queenKingXPos = QUEEN_KING_X_POS[getColorIndex(m_bottomColor)];
-        addPiece(Piece::Type::QUEEN, 0, color, queenKingXPos.first, otherStartingYPos);
-        addPiece(Piece::Type::KING, 0, color, queenKingXPos.second, otherStartingYPos, true);
+        addPiece(Piece::Type::KNIGHT, color, 1, otherStartingYPos);
+        addPiece(Piece::Type::KNIGHT, color, 6, otherStartingYPos);
+        addPiece(Piece::Type::BISHOP, color, 2, otherStartingYPos);
+        addPiece(Piece::Type::BISHOP, color, 5, otherStartingYPos);
+        addPiece(Piece::Type::ROOK, color, 0, otherStartingYPos);
+        addPiece(Piece::Type::ROOK, color, 7, otherStartingYPos);
+
+        const auto& queenKingXPos = QUEEN_KING_X_POS[getColorIndex(m_position.bottomColor)];
+        addPiece(Piece::Type::QUEEN, color, queenKingXPos.first, otherStartingYPos);
+        addPiece(Piece::Type::KING, color, queenKingXPos.second, otherStartingYPos);
     }
 
-    void Chess::addPiece(Piece::Type type, unsigned char id, Piece::eColor color, position_t x, position_t y, bool isKing)
+    void Chess::addPiece(Piece::Type type, Piece::eColor color, position_t x, position_t y)
     {
         assert(type == Piece::Type::PAWN ||
                type == Piece::Type::KNIGHT ||
@@ -425,383 +721,275 @@ namespace cchess
         auto pos = convert2Dto1DPosition(x, y, BOARD_WIDTH);
         assert(isPositionValid(pos));
         if(isPositionValid(pos)) {
-            m_board[pos] = Piece(type, id, color);
+            m_position.board.setPiece(pos, Piece(type, color));
 
-            if(isKing)
-                m_king[getColorIndex(color)] = PieceInformation(Piece(type, id, color), x, y);
-            else
-                m_alivePieces[getColorIndex(color)].emplace_back(Piece(type, id, color), x, y);
+            // the kings are only on the board
+            if(type != Piece::Type::KING)
+                m_alivePieces[getColorIndex(color)].addPiece(Piece(type, color), pos);
         }
     }
 
-    void Chess::updatePositionIfKing(Piece piece, Piece::eColor color, position_t x, position_t y) const
+    void Chess::resetAlivePieces()
     {
-        if(piece.getType() == Piece::Type::KING)
-            updateKingPosition(color, x, y);
-    }
-
-    void Chess::updateKingPosition(Piece::eColor color, position_t x, position_t y) const
-    {
-        m_king[getColorIndex(color)].m_position = Position(x, y);
-    }
-
-    bool Chess::movePawn(Piece piece, Piece::eColor fromColor, Piece::color_index_type fromColorIndex, position_t xs, position_t ys, position_t xd, position_t yd)
-    {
-        const auto& lastEnPassantPosition = m_enPassant[fromColorIndex];
-        if(yd == ys + 2 || yd == ys - 2) {
-            const auto moves = isMoveValid(piece, xs, ys, xd, yd, *this);
-            if(tryMove(moves)) {
-                for(const auto& t : moves) {
-                    auto tp = std::get<0>(t);
-                    auto txs = std::get<1>(t);
-                    auto tys = std::get<2>(t);
-                    auto txd = std::get<3>(t);
-                    auto tyd = std::get<4>(t);
-                    m_boardStateManager.updateStateOnMove(tp, txs, tys, txd, tyd);
-                }
-                m_boardHistoryManager.addMoveToHistory(moves);
-                m_boardHistoryManager.addLastEnPassant(fromColor, lastEnPassantPosition.x, lastEnPassantPosition.y);
-                m_enPassant[fromColorIndex] = Position(xd, yd);
-
-                checkPawnPromotion(xd, yd);
-                m_currentColorsTurn = getOppositeColor(m_currentColorsTurn);
-                return true;
-            }
-        } else {
-            const auto moves = isMoveValid(piece, xs, ys, xd, yd, *this);
-            if(tryMove(moves)) {
-                for(const auto& t : moves) {
-                    auto tp = std::get<0>(t);
-                    auto txs = std::get<1>(t);
-                    auto tys = std::get<2>(t);
-                    auto txd = std::get<3>(t);
-                    auto tyd = std::get<4>(t);
-                    m_boardStateManager.updateStateOnMove(tp, txs, tys, txd, tyd);
-                }
-                m_boardHistoryManager.addMoveToHistory(moves);
-                m_boardHistoryManager.addLastEnPassant(fromColor, lastEnPassantPosition.x, lastEnPassantPosition.y);
-                m_enPassant[fromColorIndex] = Position(-1, -1);
-
-                checkPawnPromotion(xd, yd);
-                m_currentColorsTurn = getOppositeColor(m_currentColorsTurn);
-                return true;
-            } else {
-                const auto captures = isPawnSpecialCaptureValid(piece, xs, ys, xd, yd, *this);
-                if(std::get<0>(captures)) {
-                    auto xc = std::get<1>(captures);
-                    auto yc = std::get<2>(captures);
-                    auto captureResult = tryCapture(piece, xs, ys, xd, yd, xc, yc);
-                    if(captureResult.first) {
-                        auto pieceCaptured = captureResult.second;
-                        auto toColor = pieceCaptured.getColor();
-                        m_deadPieces[getColorIndex(toColor)].push_back(PieceInformation(pieceCaptured, xc, yc));
-                        m_boardStateManager.updateStateOnCapture(piece, pieceCaptured, xs, ys, xd, yd, xc, yc);
-                        m_boardHistoryManager.addCaptureToHistory(toColor, piece.hasMoved(), xs, ys, xd, yd);
-                        m_boardHistoryManager.addLastEnPassant(fromColor, lastEnPassantPosition.x, lastEnPassantPosition.y);
-                        m_enPassant[fromColorIndex] = Position(-1, -1);
-
-                        checkPawnPromotion(xd, yd);
-                        m_currentColorsTurn = getOppositeColor(m_currentColorsTurn);
-                        return true;
-                    }
-                }
+        // the piece lists are not part of the position, they are built back from its board
+        for(auto color : { Piece::eColor::white, Piece::eColor::black }) {
+            auto& alivePieces = m_alivePieces[getColorIndex(color)];
+            alivePieces.clear();
+
+            auto pieces = m_position.board.getPieces(color) & ~m_position.board.getPieces(Piece::Type::KING);
+            while(pieces) {
+                auto square = popFirstSquare(pieces);
+                alivePieces.addPiece(m_position.board.getPiece(square), square);
             }
         }
-
-        return false;
     }
 
     void Chess::checkPawnPromotion(position_t x, position_t y)
     {
         if(y == RANK_1 || y == RANK_8) {
-            auto pieceToPromote = m_board[convert2Dto1DPosition(x, y, BOARD_WIDTH)];
+            auto pieceToPromote = m_position.board.getPiece(convert2Dto1DPosition(x, y, BOARD_WIDTH));
 
             m_isWaitingForPromotion = true;
             m_colorWaitingForPromotion = pieceToPromote.getColor();
             m_positionForPromotion = Position(x, y);
-
-            m_boardHistoryManager.addPromotionToHistory(pieceToPromote, x, y);
         }
     }
 
-    std::vector<Chess::PieceInformation> Chess::copyAlivePiecesExcept(Piece piece, Piece::eColor color) const
+    void Chess::updatePieceInformation(Piece::eColor color, position_t fromSquare, Piece piece, position_t toSquare)
     {
-        std::vector<PieceInformation> ret;
-        for(const auto& alivePieceInformation : getAlivePieces(color)) {
-            if(piece != alivePieceInformation.getPiece())
-                ret.push_back(alivePieceInformation);
-        }
-
-        return ret;
-    }
-
-    Piece Chess::simulateMove(position_t fromPos, position_t toPos, position_t xd, position_t yd) const
-    {
-        std::swap(m_board[fromPos], m_board[toPos]);
-        assert(m_board[fromPos].isEmpty());
-
-        return m_board[toPos];
+        if(piece.getType() != Piece::Type::KING)
+            m_alivePieces[getColorIndex(color)].movePiece(fromSquare, toSquare, piece);
     }
 
-    void Chess::reverseMove(position_t fromPos, position_t toPos, position_t xs, position_t ys) const
+    unsigned char Chess::getCastlingRight(Piece::eColor color, position_t rookX) const
     {
-        std::swap(m_board[toPos], m_board[fromPos]);
-        assert(m_board[toPos].isEmpty());
+        // the king side is on the right of a board with white on the bottom, and on the left otherwise
+        const bool isKingSide = (rookX != 0) == (m_position.bottomColor == Piece::eColor::white);
+        return static_cast<unsigned char>(1 << (getColorIndex(color) * 2 + (isKingSide ? 0 : 1)));
     }
 
-    void Chess::finalizeMove(const PieceInformation& movedPieceInformation, Piece::eColor color)
+    unsigned char Chess::getCastlingRightOfSquare(position_t square) const
     {
-        // set the moved flag on board
-        const auto& movedPiecePosition = movedPieceInformation.getPosition();
-        auto pos = convert2Dto1DPosition(movedPiecePosition.x, movedPiecePosition.y, BOARD_WIDTH);
-        m_board[pos].setMovedFlag();
-
-        // update position on alive pieces, and update the moved flag
-        if(movedPieceInformation.getPiece().getType() == Piece::Type::KING) {
-            auto& king = m_king[getColorIndex(color)];
-//            king = movedPieceInformation;
-            king.m_piece.setMovedFlag();
-        } else {
-            for(auto& pieceInformation : m_alivePieces[getColorIndex(color)]) {
-                if(movedPieceInformation.getPiece() == pieceInformation.getPiece()) {
-                    pieceInformation = movedPieceInformation;
-                    pieceInformation.m_piece.setMovedFlag();
-                    break;
-                }
+        // the rooks that can castle are in the corners
+        const auto x = getSquareX(square);
+        const auto y = getSquareY(square);
+        if(x == 0 || x == static_cast<position_t>(BOARD_WIDTH - 1)) {
+            for(auto color : { Piece::eColor::white, Piece::eColor::black }) {
+                if(y == getBackRank(color))
+                    return getCastlingRight(color, x);
             }
         }
+
+        return NO_CASTLING_RIGHTS;
     }
 
-    // returns
-    // first - piece that moved
-    // second - piece that has been captured
-    std::pair<Piece, Piece> Chess::simulateCapture(position_t fromPos, position_t toPos, position_t capturePos, position_t xd, position_t yd) const
+    Move Chess::findLegalMove(position_t xs, position_t ys, position_t xd, position_t yd) const
     {
-        std::pair<Piece, Piece> ret;
-        assert(!m_board[capturePos].isEmpty());
-        assert(!m_board[fromPos].isEmpty());
-
-        std::swap(ret.second, m_board[capturePos]);
-        std::swap(m_board[fromPos], m_board[toPos]);
-        assert(m_board[fromPos].isEmpty());
-        ret.first = m_board[toPos];
+        if(!isSquareValid(xs, ys) || !isSquareValid(xd, yd) || isSelfMove(xs, ys, xd, yd))
+            return Move();
+
+        const auto fromPiece = getBoardPiece(xs, ys);
+        const auto toPiece = getBoardPiece(xd, yd);
+        if(fromPiece.isEmpty() || fromPiece.getColor() != m_position.sideToMove)
+            return Move();
+
+        Move move;
+        if(toPiece.isEmpty()) {
+            move = isMoveValid(fromPiece, xs, ys, xd, yd, *this);
+
+            // an en passant capture goes to an empty square
+            if(move.isEmpty() && fromPiece.getType() == Piece::Type::PAWN)
+                move = isPawnSpecialCaptureValid(fromPiece, xs, ys, xd, yd, *this);
+        } else if(fromPiece.getColor() != toPiece.getColor()) {
+            move = isCaptureValid(fromPiece, xs, ys, xd, yd, *this);
+        }
 
-        return ret;
-    }
+        if(!move.isEmpty() && MoveLegality(fromPiece.getColor(), *this).isLegal(move))
+            return move;
 
-    void Chess::reverseCapture(position_t fromPos, position_t toPos, position_t capturePos, position_t xs, position_t ys, Piece& temporary) const
-    {
-        std::swap(m_board[toPos], m_board[fromPos]);
-        std::swap(m_board[capturePos], temporary);
+        return Move();
     }
 
-    void Chess::removePieceFormAlivePieces(Piece piece)
+    Piece Chess::makeMove(Move move, bool isStateRecorded)
     {
-        auto color = piece.getColor();
-        auto& alivePieces = m_alivePieces[getColorIndex(color)];
-        for(std::size_t  i = 0, i_size = alivePieces.size(); i < i_size; ++i) {
-            const auto& alivePiece = alivePieces[i];
-            if(alivePiece.getPiece() == piece) {
-                std::swap(alivePieces[i], alivePieces.back());
-                alivePieces.pop_back();
-                i_size = alivePieces.size();
-                break;
+        const auto fromSquare = move.getFrom();
+        const auto toSquare = move.getTo();
+        const auto flag = move.getFlag();
+        const auto movedPiece = m_position.board.getPiece(fromSquare);
+        const auto color = movedPiece.getColor();
+        auto& enPassant = m_position.enPassant[getColorIndex(color)];
+
+        BoardHistoryManager::UndoRecord record;
+        record.move = move;
+        record.movedPiece = movedPiece;
+        record.enPassantSquare = enPassant;
+        record.previousState = m_boardStateManager.getCurrentState();
+        record.halfmoveClock = m_position.halfmoveClock;
+        record.castlingRights = m_position.castlingRights;
+        record.isStateRecorded = isStateRecorded;
+
+        // the castling rights and the en passant file of the position are about to change
+        m_boardStateManager.togglePositionState(*this);
+
+        // the king always castles to an empty square
+        if(flag != Move::eFlag::Castling) {
+            const auto capturedSquare = getCapturedSquare(move);
+            if(!m_position.board.isEmpty(capturedSquare)) {
+                record.capturedPiece = m_position.board.removePiece(capturedSquare);
+
+                m_alivePieces[getColorIndex(record.capturedPiece.getColor())].removePiece(capturedSquare);
             }
         }
-    }
-
-    bool Chess::tryMove(const std::vector<std::tuple<Piece, position_t, position_t, position_t, position_t>>&  moves)
-    {
-        if(moves.size()) {
-            auto color = std::get<0>(moves[0]).getColor();
-            std::vector<PieceInformation> piecesMoved;
-
-            for(const auto& t : moves) {
-                auto piece = std::get<0>(t);
-                auto xs = std::get<1>(t);
-                auto ys = std::get<2>(t);
-                auto xd = std::get<3>(t);
-                auto yd = std::get<4>(t);
 
-                auto fromPos = convert2Dto1DPosition(xs, ys, BOARD_WIDTH);
-                auto toPos = convert2Dto1DPosition(xd, yd, BOARD_WIDTH);
+        // a promotion that already knows its type is done with the move
+        auto piece = flag == Move::eFlag::Promotion ? Piece(move.getTypeToPromoteTo(), color) : movedPiece;
+        m_position.board.removePiece(fromSquare);
+        m_position.board.setPiece(toSquare, piece);
+        updatePieceInformation(color, fromSquare, piece, toSquare);
+
+        // a castling also moves the rook
+        if(flag == Move::eFlag::Castling) {
+            const auto rookMove = getCastlingRookMove(move);
+            auto rook = m_position.board.removePiece(rookMove.getFrom());
+            m_position.board.setPiece(rookMove.getTo(), rook);
+            updatePieceInformation(color, rookMove.getFrom(), rook, rookMove.getTo());
+        }
 
-                auto pieceMoved = simulateMove(fromPos, toPos, xd, yd);
-//                if(!pieceMoved.isEmpty())
-                assert(!pieceMoved.isEmpty());
-                piecesMoved.emplace_back(pieceMoved, xd, yd);
-                updatePositionIfKing(piece, color, xd, yd);
-            }
+        // a pawn that moved two squares can be captured en passant on the next move
+        const auto ys = getSquareY(fromSquare);
+        const auto yd = getSquareY(toSquare);
+        if(movedPiece.getType() == Piece::Type::PAWN && (yd == ys + 2 || yd == ys - 2))
+            enPassant = static_cast<std::int8_t>(toSquare);
+        else
+            enPassant = NO_SQUARE;
+
+        // a king that moves loses both castling rights, and a rook loses its own
+        // when it moves or gets captured
+        if(m_position.castlingRights) {
+            if(movedPiece.getType() == Piece::Type::KING)
+                m_position.castlingRights &= ~(getCastlingRight(color, 0) | getCastlingRight(color, static_cast<position_t>(BOARD_WIDTH - 1)));
+            m_position.castlingRights &= ~(getCastlingRightOfSquare(fromSquare) | getCastlingRightOfSquare(toSquare));
+        }
 
-            const auto& king = getKing(color);
-            const auto& kingPosition = king.getPosition();
-            auto piecesThatCheck = isCheck(king, kingPosition.x, kingPosition.y, *this);
-            if(piecesThatCheck.size()) {
-                for(auto it = moves.rbegin(), it_end = moves.rend(); it != it_end; ++it) {
-                    const auto& t = *it;
-                    auto piece = std::get<0>(t);
-                    auto xs = std::get<1>(t);
-                    auto ys = std::get<2>(t);
-                    auto xd = std::get<3>(t);
-                    auto yd = std::get<4>(t);
-
-                    auto fromPos = convert2Dto1DPosition(xs, ys, BOARD_WIDTH);
-                    auto toPos = convert2Dto1DPosition(xd, yd, BOARD_WIDTH);
-
-                    reverseMove(fromPos, toPos, xs, ys);
-                    updatePositionIfKing(piece, color, xs, ys);
-                }
+        // the fifty-move rule counts from the last capture or pawn move
+        if(movedPiece.getType() == Piece::Type::PAWN || !record.capturedPiece.isEmpty())
+            m_position.halfmoveClock = 0;
+        else
+            ++m_position.halfmoveClock;
 
-                return false;
-            }
+        if(color == Piece::eColor::black)
+            ++m_position.fullmoveNumber;
 
-            for(const auto& movedPieceInformation : piecesMoved) {
-                finalizeMove(movedPieceInformation, color);
-            }
+        m_position.sideToMove = getOppositeColor(color);
+        m_boardStateManager.updateState(m_position.board, move, movedPiece, record.capturedPiece);
+        m_boardStateManager.togglePositionState(*this);
+        if(isStateRecorded)
+            m_boardStateManager.recordState(m_position.halfmoveClock);
 
-            return true;
-        }
+        m_boardHistoryManager.addRecord(record);
+        assert(m_boardStateManager.isStateValid(*this));
 
-        return false;
+        return record.capturedPiece;
     }
 
-    std::pair<bool, Piece> Chess::tryCapture(Piece piece, position_t xs, position_t ys, position_t xd, position_t yd, position_t xc, position_t yc)
+    void Chess::undoLastRecord()
     {
-        auto color = piece.getColor();
-        auto oppositeColor = getOppositeColor(color);
-        auto fromPos = convert2Dto1DPosition(xs, ys, BOARD_WIDTH);
-        auto toPos = convert2Dto1DPosition(xd, yd, BOARD_WIDTH);
-        auto capturePos = convert2Dto1DPosition(xc, yc, BOARD_WIDTH);
-
-        assert(!m_board[capturePos].isEmpty());
-        assert(!m_board[fromPos].isEmpty());
-
-        auto temporaryToRemove = m_board[capturePos];
-        auto temporaryAlivePieces = copyAlivePiecesExcept(temporaryToRemove, oppositeColor);
-        updatePositionIfKing(piece, color, xd, yd);
+        const auto record = m_boardHistoryManager.getLastRecord();
+        m_boardHistoryManager.removeLastRecord();
+
+        const auto move = record.move;
+        const auto fromSquare = move.getFrom();
+        const auto toSquare = move.getTo();
+        const auto color = record.movedPiece.getColor();
+
+        if(move.getFlag() == Move::eFlag::Castling) {
+            const auto rookMove = getCastlingRookMove(move);
+            auto rook = m_position.board.removePiece(rookMove.getTo());
+            m_position.board.setPiece(rookMove.getFrom(), rook);
+            updatePieceInformation(color, rookMove.getTo(), rook, rookMove.getFrom());
+        }
 
-        auto simulatedCaptureResult = simulateCapture(fromPos, toPos, capturePos, xd, yd);
-        const auto& king = getKing(color);
-        const auto& kingPosition = king.getPosition();
-        auto piecesThatCheck = isCheck(kingPosition.x, kingPosition.y, *this, temporaryAlivePieces);
-        if(piecesThatCheck.size()) {
-            reverseCapture(fromPos, toPos, capturePos, xs, ys, simulatedCaptureResult.second);
-            updatePositionIfKing(piece, color, xs, ys);
+        // the piece is put back as it was, which also takes back a promotion
+        m_position.board.removePiece(toSquare);
+        m_position.board.setPiece(fromSquare, record.movedPiece);
+        updatePieceInformation(color, toSquare, record.movedPiece, fromSquare);
 
-            return { false, simulatedCaptureResult.second };
+        if(!record.capturedPiece.isEmpty()) {
+            const auto capturedSquare = getCapturedSquare(move);
+            const auto capturedColorIndex = getColorIndex(record.capturedPiece.getColor());
+            m_position.board.setPiece(capturedSquare, record.capturedPiece);
+            m_alivePieces[capturedColorIndex].addPiece(record.capturedPiece, capturedSquare);
         }
 
-        // remove the capture piece from the alive pieces
-        removePieceFormAlivePieces(simulatedCaptureResult.second);
+        m_position.enPassant[getColorIndex(color)] = record.enPassantSquare;
+        m_position.halfmoveClock = record.halfmoveClock;
+        m_position.castlingRights = record.castlingRights;
+        if(color == Piece::eColor::black)
+            --m_position.fullmoveNumber;
 
-        // update the moved piece
-        finalizeMove(PieceInformation(simulatedCaptureResult.first, xd, yd), color);
+        if(record.isStateRecorded)
+            m_boardStateManager.undoLastState();
+        m_boardStateManager.setCurrentState(record.previousState);
 
-        return { true, simulatedCaptureResult.second };
+        m_position.sideToMove = color;
+        assert(m_boardStateManager.isStateValid(*this));
     }
 
-    bool Chess::tryTemporaryMove(const std::vector<std::tuple<Piece, position_t, position_t, position_t, position_t>>& moves) const
+    Chess::valid_moves_container_type Chess::getValidMoves(Piece piece, position_t x, position_t y) const
     {
-        bool ret = true;
-        if(moves.size()) {
-            auto color = std::get<0>(moves[0]).getColor();
-            for(const auto& t : moves) {
-                auto piece = std::get<0>(t);
-                auto xs = std::get<1>(t);
-                auto ys = std::get<2>(t);
-                auto xd = std::get<3>(t);
-                auto yd = std::get<4>(t);
-
-                auto fromPos = convert2Dto1DPosition(xs, ys, BOARD_WIDTH);
-                auto toPos = convert2Dto1DPosition(xd, yd, BOARD_WIDTH);
-
-                simulateMove(fromPos, toPos, xd, yd);
-                updatePositionIfKing(piece, color, xd, yd);
+        valid_moves_container_type ret;
+
+        // generate the moves of the whole color, and keep the ones that start from the piece
+        MoveList moves;
+        generateLegalMoves(piece.getColor(), moves);
+
+        auto fromSquare = convert2Dto1DPosition(x, y, BOARD_WIDTH);
+        for(const auto& move : moves) {
+            if(move.getFrom() == fromSquare) {
+                // a promotion is shown once, the type is chosen after the move
+                if(move.getFlag() != Move::eFlag::Promotion || move.getTypeToPromoteTo() == Piece::Type::QUEEN)
+                    ret.emplace_back(getSquareX(move.getTo()), getSquareY(move.getTo()));
             }
-
-            if(isOnCheck(color))
-                ret = false;
-
-            for(auto it = moves.rbegin(), it_end = moves.rend(); it != it_end; ++it) {
-                const auto& t = *it;
-                auto piece = std::get<0>(t);
-                auto xs = std::get<1>(t);
-                auto ys = std::get<2>(t);
-                auto xd = std::get<3>(t);
-                auto yd = std::get<4>(t);
-
-                auto fromPos = convert2Dto1DPosition(xs, ys, BOARD_WIDTH);
-                auto toPos = convert2Dto1DPosition(xd, yd, BOARD_WIDTH);
-
-                reverseMove(fromPos, toPos, xs, ys);
-                updatePositionIfKing(piece, color, xs, ys);
-            }
-
-            return ret;
         }
 
-        return false;
+        return ret;
     }
 
-    bool Chess::tryTemporaryCapture(Piece piece, position_t xs, position_t ys, position_t xd, position_t yd, position_t xc, position_t yc) const
+    void Chess::PieceList::clear()
     {
-        bool ret = true;
-        auto color = piece.getColor();
-        auto oppositeColor = getOppositeColor(color);
-        auto fromPos = convert2Dto1DPosition(xs, ys, BOARD_WIDTH);
-        auto toPos = convert2Dto1DPosition(xd, yd, BOARD_WIDTH);
-        auto capturePos = convert2Dto1DPosition(xc, yc, BOARD_WIDTH);
-
-        assert(!m_board[capturePos].isEmpty());
-        assert(!m_board[fromPos].isEmpty());
-        auto temporaryToRemove = m_board[capturePos];
-        auto temporaryAlivePieces = copyAlivePiecesExcept(temporaryToRemove, oppositeColor);
-        updatePositionIfKing(piece, color, xd, yd);
+        m_size = 0;
+        m_slots.fill(NO_SLOT);
+    }
 
-        // simulate the capture
-        auto simulatedCaptureResult = simulateCapture(fromPos, toPos, capturePos, xd, yd);
-        const auto& king = getKing(color);
-        const auto& kingPosition = king.getPosition();
-        if(isCheck(kingPosition.x, kingPosition.y, *this, temporaryAlivePieces).size())
-            ret = false;
+    void Chess::PieceList::addPiece(Piece piece, position_t square)
+    {
+        assert(!hasPiece(square) && m_size < m_pieces.size());
 
-        reverseCapture(fromPos, toPos, capturePos, xs, ys, simulatedCaptureResult.second);
-        updatePositionIfKing(piece, color, xs, ys);
+        m_slots[square] = m_size;
+        m_pieces[m_size++] = PieceInformation(piece, getSquareX(square), getSquareY(square));
+    }
 
-        return ret;
+    void Chess::PieceList::removePiece(position_t square)
+    {
+        assert(hasPiece(square));
+
+        // the last piece takes the slot of the removed one
+        auto slot = m_slots[square];
+        const auto& last = m_pieces[--m_size];
+        m_slots[getSquare(last.getPosition().x, last.getPosition().y)] = slot;
+        m_pieces[slot] = last;
+        m_slots[square] = NO_SLOT;
     }
 
-    std::vector<Chess::Position> Chess::getValidMoves(Piece piece, position_t x, position_t y) const
-    {
-        std::vector<Chess::Position> ret;
-        ret.reserve(100);
-
-        for(position_t j = 0; j < static_cast<position_t>(BOARD_HEIGHT); ++j) {
-            for(position_t i = 0; i < static_cast<position_t>(BOARD_WIDTH); ++i) {
-                if(x != i || y != j) {
-                    Piece dstPiece = getBoardPiece(i, j);
-                    if(dstPiece.isEmpty()) {
-                        auto moves = isMoveValid(piece, x, y, i, j, *this);
-                        if(tryTemporaryMove(moves))
-                            ret.emplace_back(i, j);
-
-                        if(piece.getType() == Piece::Type::PAWN) {
-                            auto captureResult = isPawnSpecialCaptureValid(piece, x, y, i, j, *this);
-                            if(std::get<0>(captureResult))
-                                ret.emplace_back(i, j);
-                        }
-                    } else {
-                        if(piece.getColor() != dstPiece.getColor()) {
-                            auto captures = isCaptureValid(piece, x, y, i, j, *this);
-                            if(std::get<0>(captures) && tryTemporaryCapture(piece, x, y, i, j, std::get<1>(captures), std::get<2>(captures)))
-                                ret.emplace_back(i, j);
-                        }
-                    }
-                }
-            }
-        }
+    void Chess::PieceList::movePiece(position_t fromSquare, position_t toSquare, Piece piece)
+    {
+        assert(hasPiece(fromSquare));
+        assert(fromSquare == toSquare || !hasPiece(toSquare));
 
-        return ret;
+        auto slot = m_slots[fromSquare];
+        m_slots[fromSquare] = NO_SLOT;
+        m_slots[toSquare] = slot;
+        m_pieces[slot] = PieceInformation(piece, getSquareX(toSquare), getSquareY(toSquare));
     }
 
     bool operator==(const Chess::PieceInformation& lhs, const Chess::PieceInformation& rhs)
@@ -831,69 +1019,27 @@ namespace cchess
 
     std::pair<position_t, position_t> convertStringPositionToInt(const std::string& pos)
     {
-        static const std::unordered_map<char, position_t> CHAR_TO_INT =
-        {
-            { 'a', 0 },
-            { 'b', 1 },
-            { 'c', 2 },
-            { 'd', 3 },
-            { 'e', 4 },
-            { 'f', 5 },
-            { 'g', 6 },
-            { 'h', 7 }
-        };
-
-        static const std::unordered_map<char, position_t> INT_TO_INT =
-        {
-            { '1', 7 },
-            { '2', 6 },
-            { '3', 5 },
-            { '4', 4 },
-            { '5', 3 },
-            { '6', 2 },
-            { '7', 1 },
-            { '8', 0 },
-        };
-
+        // the files go from a to h left to right, and the ranks from 8 to 1 top to bottom
         assert(pos.size() == 2);
         if(pos.size() == 2) {
-            auto cit = CHAR_TO_INT.find(pos[0]);
-            auto iit = INT_TO_INT.find(pos[1]);
+            auto file = pos[0];
+            auto rank = pos[1];
 
-            if(cit != CHAR_TO_INT.end() && iit != INT_TO_INT.end())
-                return std::make_pair((*cit).second, (*iit).second);
-
-            return std::make_pair(-1, -1);
+            if(file >= 'a' && file <= 'h' && rank >= '1' && rank <= '8')
+                return std::make_pair(static_cast<position_t>(file - 'a'), static_cast<position_t>('8' - rank));
         }
 
         return std::make_pair(-1, -1);
     }
 
-    std::vector<Chess::PieceInformation> isCheck(const Chess::PieceInformation& king, position_t xd, position_t yd, const Chess& chessboard)
+    std::string convertIntPositionToString(position_t x, position_t y)
     {
-        std::vector<Chess::PieceInformation> ret;
-        assert(king.getPiece().getType() == Piece::Type::KING);
-        auto oppositeColor = getOppositeColor(king.getPiece().getColor());
-        for(const auto& pieceInformation : chessboard.getAlivePieces(oppositeColor)) {
-            auto piece = pieceInformation.getPiece();
-            const auto& piecePosition = pieceInformation.getPosition();
-            if(std::get<0>(isCaptureValid(piece, piecePosition.x, piecePosition.y, xd, yd, chessboard)))
-                ret.push_back(pieceInformation);
-        }
+        // the inverse of convertStringPositionToInt, white is on the bottom
+        assert(isSquareValid(x, y));
 
-        return ret;
-    }
-
-    std::vector<Chess::PieceInformation> isCheck(position_t xd, position_t yd, const Chess& chessboard, const std::vector<Chess::PieceInformation>& alivePieces)
-    {
-        std::vector<Chess::PieceInformation> ret;
-
-        for(const auto& pieceInformation : alivePieces) {
-            auto piece = pieceInformation.getPiece();
-            const auto& piecePosition = pieceInformation.getPosition();
-            if(std::get<0>(isCaptureValid(piece, piecePosition.x, piecePosition.y, xd, yd, chessboard)))
-                ret.push_back(pieceInformation);
-        }
+        std::string ret;
+        ret += static_cast<char>('a' + x);
+        ret += static_cast<char>('8' - y);
 
         return ret;
     }
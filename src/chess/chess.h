@@ -17,10 +17,17 @@
 #pragma once
 
 // headers
+#include <array>
 #include <cinttypes>
+#include <string>
+#include <string_view>
+#include <type_traits>
 #include <vector>
-#include "3rdparty/container/fixed_sized_array.h"
+#include "3rdparty/container/static_vector.h"
 #include "3rdparty/high_resolution_clock.h"
+#include "board/board.h"
+#include "move/move.h"
+#include "move/moveList.h"
 #include "piece/piece.h"
 #include "snapshot/boardHistory.h"
 #include "snapshot/boardStateManager.h"
@@ -29,8 +36,6 @@
 
 namespace cchess
 {
-    /// Todo:
-    /// Fix problem where promoted pieces don't have unique ids
     class Chess
     {
     public:
@@ -44,6 +49,17 @@ namespace cchess
         static constexpr position_t RANK_1 = 0;
         static constexpr position_t RANK_8 = BOARD_HEIGHT - 1;
 
+        // a queen in the middle of an empty board has the most moves
+        static constexpr std::size_t MAX_PIECE_MOVES = 27;
+        static constexpr std::size_t MAX_PIECES_PER_COLOR = 16;
+        static constexpr unsigned int FIFTY_MOVE_RULE_PLIES = 100;
+        static constexpr std::int8_t NO_SQUARE = -1;
+
+        // a castling right for each color and side of the board, kept as K Q k q
+        // whatever the side of the board the colors are on
+        static constexpr unsigned char NO_CASTLING_RIGHTS = 0;
+        static constexpr unsigned char ALL_CASTLING_RIGHTS = 0x0F;
+
         struct Position
         {
             Position() {}
@@ -66,7 +82,6 @@ namespace cchess
 
         private:
             friend class Chess;
-            friend class BoardHistoryManager;
 
             friend bool operator==(const Chess::PieceInformation& lhs, const Chess::PieceInformation& rhs);
 
@@ -74,14 +89,66 @@ namespace cchess
             Position    m_position;
         };
 
+        // the alive pieces of a color, with the slot of each square,
+        // so that a piece is updated or removed without searching for it
+        class PieceList
+        {
+        public:
+            using container_type = std::array<PieceInformation, MAX_PIECES_PER_COLOR>;
+            using const_iterator = container_type::const_iterator;
+
+            PieceList() { clear(); }
+
+            void clear();
+            void addPiece(Piece piece, position_t square);
+            void removePiece(position_t square);
+            void movePiece(position_t fromSquare, position_t toSquare, Piece piece);
+
+            bool hasPiece(position_t square) const { return m_slots[square] != NO_SLOT; }
+            const PieceInformation& getPiece(position_t square) const { return m_pieces[m_slots[square]]; }
+
+            std::size_t size() const { return m_size; }
+            bool empty() const { return !m_size; }
+            const_iterator begin() const { return m_pieces.begin(); }
+            const_iterator end() const { return m_pieces.begin() + m_size; }
+
+        private:
+            static constexpr unsigned char NO_SLOT = 0xFF;
+
+            container_type                                  m_pieces;
+            std::array<unsigned char, NUMBER_OF_SQUARES>    m_slots;
+            unsigned char                                   m_size;
+        };
+
+        // everything needed to play from a position, kept in one trivially copyable block,
+        // so a position can be cloned with a plain copy. what the board already tells
+        // (the kings, the piece lists) is left out. the game bookkeeping (history,
+        // repetitions, clocks, captured pieces, piece lists) stays in Chess
+        struct PositionState
+        {
+            Board               board;
+            std::int8_t         enPassant[Piece::NUMBER_OF_COLOR];  // the square of the pawn of each color that just moved two squares
+            unsigned int        halfmoveClock;
+            unsigned int        fullmoveNumber;                     // starts at 1, and goes up after each black move
+            unsigned char       castlingRights;
+            Piece::eColor       sideToMove;
+            Piece::eColor       bottomColor;                        // the board is laid out from this color's side
+        };
+
         using pieces_information_container_type = std::vector<PieceInformation>;
-        using select_piece_return_type = std::pair<PieceInformation, std::vector<Position>>;
+        using valid_moves_container_type = mar::container::static_vector<Position, MAX_PIECE_MOVES>;
+        using select_piece_return_type = std::pair<PieceInformation, valid_moves_container_type>;
 
         Chess();
 
         void update();
         void resetBoard(Piece::eColor bottomColor, bool hasTurnClock = false, bool disableOppositeColorHint = true);
 
+        // Forsyth-Edwards Notation, the board keeps its bottom color.
+        // an invalid FEN returns false and leaves the game as it was
+        bool setFromFEN(std::string_view fen);
+        std::string toFEN() const;
+
         int getTimeLeft(Piece::eColor color);
         void resetTimer();
 
@@ -89,79 +156,98 @@ namespace cchess
         select_piece_return_type selectPiece(const std::string& pos) const;
         EMoveResult move(position_t xs, position_t ys, position_t xd, position_t yd);
         EMoveResult move(const std::string& from, const std::string& to);
+        EMoveResult move(Move move);
         bool undo();
 
+        // whether the move, coming from anywhere (a hash table, another position), can be played here
+        bool isMoveLegal(Move move) const;
+
+        // lean make/unmake for search, the move must be legal.
+        // the moves are not part of the threefold repetition states
+        void doMove(Move move);
+        void undoMove();
+
         bool isOnCheck(Piece::eColor color) const;
+        // the pieces of both colors on the occupancy that attack the square
+        bitboard_t getAttackersTo(position_t square, bitboard_t occupancy) const;
+        bool isSquareAttacked(position_t square, Piece::eColor color) const;
         bool isCheckMate(Piece::eColor color) const;
         bool isStaleMate(Piece::eColor color) const;
+        bool hasAnyLegalMove(Piece::eColor color) const;
         bool isThereThreefoldRepetition() const { return m_boardStateManager.isThereThreefoldRepetition(); }
+        bool isFiftyMoveRuleReached() const { return m_position.halfmoveClock >= FIFTY_MOVE_RULE_PLIES; }
+        unsigned int getHalfmoveClock() const { return m_position.halfmoveClock; }
+        unsigned int getFullmoveNumber() const { return m_position.fullmoveNumber; }
+        BoardStateManager::state_type getZobristKey() const { return m_boardStateManager.getCurrentState(); }
+
+        Piece::eColor getCurrentColorsTurn() const { return m_position.sideToMove; }
+
+        // the position is copied as is, the history of the game starts over from it
+        const PositionState& getPositionState() const { return m_position; }
+        void setPositionState(const PositionState& position);
 
         void setTypeToPromoteTo(Piece::Type type);
         bool isWaitingForPromotion() const { return m_isWaitingForPromotion; }
 
-        position_t getPawnDirection(Piece::eColor color) const { return color == m_bottomColor ? -1 : 1; }
+        Piece::eColor getBottomColor() const { return m_position.bottomColor; }
+        position_t getPawnDirection(Piece::eColor color) const { return color == m_position.bottomColor ? -1 : 1; }
+        position_t getBackRank(Piece::eColor color) const { return color == m_position.bottomColor ? RANK_8 : RANK_1; }
+        unsigned char getCastlingRights() const { return m_position.castlingRights; }
+        bool canCastle(Piece::eColor color, position_t rookX) const { return m_position.castlingRights & getCastlingRight(color, rookX); }
         Piece getBoardPiece(position_t x, position_t y) const;
-        const pieces_information_container_type& getAlivePieces(Piece::eColor color) const { return m_alivePieces[getColorIndex(color)]; }
+        const Board& getBoard() const { return m_position.board; }
+        const PieceList& getAlivePieces(Piece::eColor color) const { return m_alivePieces[getColorIndex(color)]; }
         const pieces_information_container_type& getDeadPieces(Piece::eColor color) const { return m_deadPieces[getColorIndex(color)]; }
-        const Position& getEnPassantPosition(Piece::eColor color) const { return m_enPassant[getColorIndex(color)]; }
-        const PieceInformation& getKing(Piece::eColor color) const { return m_king[getColorIndex(color)]; }
-        std::vector<Position> getValidMoves(position_t x, position_t y) const;
+        Position getEnPassantPosition(Piece::eColor color) const;
+        position_t getKingSquare(Piece::eColor color) const { return getFirstSquare(m_position.board.getPieces(color, Piece::Type::KING)); }
+        valid_moves_container_type getValidMoves(position_t x, position_t y) const;
+        void generateLegalMoves(Piece::eColor color, MoveList& moves) const;
 
         std::string getBoardString() const;
         std::string getBoardStringPieces() const;
 
     private:
-        friend class BoardHistoryManager;
-
-        using board_container_type = mar::container::fixed_sized_array<Piece, BOARD_WIDTH * BOARD_HEIGHT>;
-
         bool isPositionValid(position_t pos) const;
 
         void initPieces(Piece::eColor color);
-        void addPiece(Piece::Type type, unsigned char id, Piece::eColor color, position_t x, position_t y, bool isKing = false);
-        void updatePositionIfKing(Piece piece, Piece::eColor color, position_t x, position_t y) const;
-        void updateKingPosition(Piece::eColor color, position_t x, position_t y) const;
+        void addPiece(Piece::Type type, Piece::eColor color, position_t x, position_t y);
+        void resetAlivePieces();
+        void updatePieceInformation(Piece::eColor color, position_t fromSquare, Piece piece, position_t toSquare);
 
-        bool movePawn(Piece piece, Piece::eColor fromColor, Piece::color_index_type fromColorIndex, position_t xs, position_t ys, position_t xd, position_t yd);
         void checkPawnPromotion(position_t x, position_t y);
 
-        std::vector<PieceInformation> copyAlivePiecesExcept(Piece piece, Piece::eColor color) const;
-        Piece simulateMove(position_t fromPos, position_t toPos, position_t xd, position_t yd) const;
-        void reverseMove(position_t fromPos, position_t toPos, position_t xs, position_t ys) const;
-        void finalizeMove(const PieceInformation& pieceInformation, Piece::eColor color);
-        std::pair<Piece, Piece> simulateCapture(position_t fromPos, position_t toPos, position_t capturePos, position_t xd, position_t yd) const;
-        void reverseCapture(position_t fromPos, position_t toPos, position_t capturePos, position_t xs, position_t ys, Piece& temporary) const;
-        void removePieceFormAlivePieces(Piece piece);
+        unsigned char getCastlingRight(Piece::eColor color, position_t rookX) const;
+        unsigned char getCastlingRightOfSquare(position_t square) const;
+
+        // the move the rules allow from a square to another, empty when there is none
+        Move findLegalMove(position_t xs, position_t ys, position_t xd, position_t yd) const;
 
-        bool tryMove(const std::vector<std::tuple<Piece, position_t, position_t, position_t, position_t>>&  moves);
-        std::pair<bool, Piece> tryCapture(Piece piece, position_t xs, position_t ys, position_t xd, position_t yd, position_t xc, position_t yc);
-        bool tryTemporaryMove(const std::vector<std::tuple<Piece, position_t, position_t, position_t, position_t>>& moves) const;
-        bool tryTemporaryCapture(Piece piece, position_t xs, position_t ys, position_t xd, position_t yd, position_t xc, position_t yc) const;
+        Piece makeMove(Move move, bool isStateRecorded);
+        void undoLastRecord();
 
-        std::vector<Position> getValidMoves(Piece piece, position_t x, position_t y) const;
+        valid_moves_container_type getValidMoves(Piece piece, position_t x, position_t y) const;
 
-        mutable board_container_type            m_board;
+        PositionState                           m_position;
+        PieceList                               m_alivePieces[Piece::NUMBER_OF_COLOR];
         BoardStateManager                       m_boardStateManager;
         BoardHistoryManager                     m_boardHistoryManager;
-        Piece::eColor                           m_bottomColor;
 
-        Piece::eColor                           m_currentColorsTurn;
         bool                                    m_disableOppositeColorHint;
 
         bool                                    m_isWaitingForPromotion;
         Piece::eColor                           m_colorWaitingForPromotion;
         Position                                m_positionForPromotion;
 
-        Position                                m_enPassant[Piece::NUMBER_OF_COLOR];
-        pieces_information_container_type       m_alivePieces[Piece::NUMBER_OF_COLOR];
         pieces_information_container_type       m_deadPieces[Piece::NUMBER_OF_COLOR];
-        mutable PieceInformation                m_king[Piece::NUMBER_OF_COLOR];
 
         mar::high_resolution_clock              m_turnClock[Piece::NUMBER_OF_COLOR];
         int                                     m_turnClockTimeLeft[Piece::NUMBER_OF_COLOR];
         bool                                    m_hasTurnClock;
     };
 
+    static_assert(std::is_trivially_copyable<Chess::PositionState>::value, "a position must be copyable as a block of memory");
+    static_assert(sizeof(Chess::PositionState) <= 3 * CACHE_LINE_SIZE, "a position should fit in three cache lines");
+
     bool operator==(const Chess::PieceInformation& lhs, const Chess::PieceInformation& rhs);
     bool operator!=(const Chess::PieceInformation& lhs, const Chess::PieceInformation& rhs);
     bool operator==(const Chess::Position& lhs, const Chess::Position& rhs);
@@ -169,6 +255,5 @@ namespace cchess
 
     position_t convert2Dto1DPosition(position_t x, position_t y, position_t width);
     std::pair<position_t, position_t> convertStringPositionToInt(const std::string& pos);
-    std::vector<Chess::PieceInformation> isCheck(const Chess::PieceInformation& king, position_t xd, position_t yd, const Chess& chessboard);
-    std::vector<Chess::PieceInformation> isCheck(position_t xd, position_t yd, const Chess& chessboard, const std::vector<Chess::PieceInformation>& alivePieces);
+    std::string convertIntPositionToString(position_t x, position_t y);
 }
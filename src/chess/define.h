@@ -23,4 +23,5 @@ namespace cchess
 {
     static constexpr std::size_t BOARD_WIDTH = 8;
     static constexpr std::size_t BOARD_HEIGHT = 8;
+    static constexpr std::size_t CACHE_LINE_SIZE = 64;
 }
@@ -0,0 +1,101 @@
+/**********
+ *
+ *     This program is free software: you can redistribute it and/or modify
+ *     it under the terms of the GNU General Public License as published by
+ *     the Free Software Foundation, either version 3 of the License, or
+ *     (at your option) any later version.
+ * 
+ *     This program is distributed in the hope that it will be useful,
+ *     but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *     MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *     GNU General Public License for more details.
+ * 
+ *     You should have received a copy of the GNU General Public License
+ *     along with this program.  If not, see <https://www.gnu.org/licenses/>. 
+ *
+ **********/
+// headers
+#include <assert.h>
+#include <cctype>
+#include "../board/bitboard.h"
+#include "../chess.h"
+#include "move.h"
+
+namespace cchess
+{
+    static constexpr Piece::Type PROMOTION_TYPES[] =
+    {
+        Piece::Type::KNIGHT,
+        Piece::Type::BISHOP,
+        Piece::Type::ROOK,
+        Piece::Type::QUEEN
+    };
+
+    Move::Move(position_t fromSquare, position_t toSquare, eFlag flag, Piece::Type typeToPromoteTo)
+    {
+        assert(fromSquare >= 0 && fromSquare < NUMBER_OF_SQUARES);
+        assert(toSquare >= 0 && toSquare < NUMBER_OF_SQUARES);
+        assert(typeToPromoteTo == Piece::Type::KNIGHT ||
+               typeToPromoteTo == Piece::Type::BISHOP ||
+               typeToPromoteTo == Piece::Type::ROOK ||
+               typeToPromoteTo == Piece::Type::QUEEN);
+
+        // knight, bishop, rook and queen have consecutive type indices
+        auto promotionIndex = getTypeIndex(typeToPromoteTo) - getTypeIndex(Piece::Type::KNIGHT);
+        m_data = static_cast<std::uint16_t>(fromSquare |
+                                            (toSquare << 6) |
+                                            (promotionIndex << 12) |
+                                            (static_cast<unsigned int>(flag) << 14));
+    }
+
+    Piece::Type Move::getTypeToPromoteTo() const
+    {
+        return PROMOTION_TYPES[(m_data >> 12) & 0x3];
+    }
+
+    bool operator==(const Move& lhs, const Move& rhs)
+    {
+        return lhs.m_data == rhs.m_data;
+    }
+
+    bool operator!=(const Move& lhs, const Move& rhs)
+    {
+        return !(lhs == rhs);
+    }
+
+    Move getCastlingRookMove(Move move)
+    {
+        // the rook has not moved, so it is still on the corner the king moved towards,
+        // and it ends up on the square the king passed through
+        assert(move.getFlag() == Move::eFlag::Castling);
+        auto xs = getSquareX(move.getFrom());
+        auto xd = getSquareX(move.getTo());
+        auto y = getSquareY(move.getFrom());
+        auto inc_x = xd > xs ? 1 : -1;
+        auto xf = inc_x > 0 ? static_cast<position_t>(BOARD_WIDTH - 1) : 0;
+
+        return Move(getSquare(xf, y), getSquare(xd - inc_x, y));
+    }
+
+    position_t getCapturedSquare(Move move)
+    {
+        // a pawn captured en passant is beside the capturing pawn, and not on the destination
+        if(move.getFlag() == Move::eFlag::EnPassant)
+            return getSquare(getSquareX(move.getTo()), getSquareY(move.getFrom()));
+
+        return move.getTo();
+    }
+
+    std::string getMoveString(Move move)
+    {
+        auto fromSquare = move.getFrom();
+        auto toSquare = move.getTo();
+        auto ret = convertIntPositionToString(getSquareX(fromSquare), getSquareY(fromSquare)) +
+                   convertIntPositionToString(getSquareX(toSquare), getSquareY(toSquare));
+
+        if(move.getFlag() == Move::eFlag::Promotion)
+            ret += static_cast<char>(tolower(static_cast<char>(move.getTypeToPromoteTo())));
+
+        return ret;
+    }
+}
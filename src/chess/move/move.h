@@ -0,0 +1,70 @@
+/**********
+ *
+ *     This program is free software: you can redistribute it and/or modify
+ *     it under the terms of the GNU General Public License as published by
+ *     the Free Software Foundation, either version 3 of the License, or
+ *     (at your option) any later version.
+ * 
+ *     This program is distributed in the hope that it will be useful,
+ *     but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *     MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *     GNU General Public License for more details.
+ * 
+ *     You should have received a copy of the GNU General Public License
+ *     along with this program.  If not, see <https://www.gnu.org/licenses/>. 
+ *
+ **********/
+#pragma once
+
+// headers
+#include <cinttypes>
+#include <string>
+#include "../piece/piece.h"
+#include "../types.h"
+
+namespace cchess
+{
+    // maximum number of legal moves a position can have
+    static constexpr std::size_t MAX_MOVES = 256;
+
+    // a move packed in 16 bits
+    // bits 0 - 5: from square
+    // bits 6 - 11: to square
+    // bits 12 - 13: type to promote to (knight, bishop, rook, queen)
+    // bits 14 - 15: flag
+    class Move
+    {
+    public:
+        enum class eFlag : unsigned char
+        {
+            Normal,
+            Castling,
+            EnPassant,
+            Promotion
+        };
+
+        Move() : m_data(0) {}
+        Move(position_t fromSquare, position_t toSquare, eFlag flag = eFlag::Normal, Piece::Type typeToPromoteTo = Piece::Type::KNIGHT);
+
+        bool isEmpty() const { return !m_data; }
+
+        position_t getFrom() const { return static_cast<position_t>(m_data & 0x3F); }
+        position_t getTo() const { return static_cast<position_t>((m_data >> 6) & 0x3F); }
+        eFlag getFlag() const { return static_cast<eFlag>(m_data >> 14); }
+        Piece::Type getTypeToPromoteTo() const;
+
+    private:
+        friend bool operator==(const Move& lhs, const Move& rhs);
+
+        std::uint16_t m_data;
+    };
+
+    bool operator==(const Move& lhs, const Move& rhs);
+    bool operator!=(const Move& lhs, const Move& rhs);
+
+    Move getCastlingRookMove(Move move);
+    position_t getCapturedSquare(Move move);
+
+    // long algebraic notation, ex: e2e4, e7e8q
+    std::string getMoveString(Move move);
+}
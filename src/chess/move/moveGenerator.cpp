@@ -0,0 +1,265 @@
+/**********
+ *
+ *     This program is free software: you can redistribute it and/or modify
+ *     it under the terms of the GNU General Public License as published by
+ *     the Free Software Foundation, either version 3 of the License, or
+ *     (at your option) any later version.
+ * 
+ *     This program is distributed in the hope that it will be useful,
+ *     but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *     MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *     GNU General Public License for more details.
+ * 
+ *     You should have received a copy of the GNU General Public License
+ *     along with this program.  If not, see <https://www.gnu.org/licenses/>. 
+ *
+ **********/
+// headers
+#include <assert.h>
+#include "../board/attacks.h"
+#include "../chess.h"
+#include "moveGenerator.h"
+#include "moveLegality.h"
+
+namespace cchess
+{
+namespace
+{
+    class LegalMoveGenerator
+    {
+    public:
+        LegalMoveGenerator(Piece::eColor color, const Chess& chessboard, MoveList& moves, eMoveGeneration generation = eMoveGeneration::All);
+
+        void generate();
+        bool hasAnyMove();
+
+    private:
+        bool isDone() const { return m_isStoppingAtFirstMove && !m_moves.empty(); }
+
+        void generatePawnMoves();
+        void generatePieceMoves(Piece::Type type);
+        void generateKingMoves();
+        void generateCastlingMoves();
+
+        void addMove(position_t fromSquare, position_t toSquare, Move::eFlag flag = Move::eFlag::Normal);
+        void addPawnMove(position_t fromSquare, position_t toSquare);
+
+        bitboard_t getPieceAttacks(Piece::Type type, position_t square) const;
+
+        const Chess&    m_chessboard;
+        const Board&    m_board;
+        MoveLegality    m_legality;
+        Piece::eColor   m_color;
+        position_t      m_pawnDirection;
+        position_t      m_kingSquare;
+        bitboard_t      m_ownPieces;
+        bitboard_t      m_enemyPieces;
+        bitboard_t      m_occupancy;
+        eMoveGeneration m_generation;
+        bitboard_t      m_targets;      // the squares the moves of the generation go to
+
+        MoveList&       m_moves;
+        bool            m_isStoppingAtFirstMove;
+    };
+
+    LegalMoveGenerator::LegalMoveGenerator(Piece::eColor color, const Chess& chessboard, MoveList& moves, eMoveGeneration generation) :
+        m_chessboard(chessboard),
+        m_board(chessboard.getBoard()),
+        m_legality(color, chessboard),
+        m_color(color),
+        m_pawnDirection(chessboard.getPawnDirection(color)),
+        m_kingSquare(m_legality.getKingSquare()),
+        m_ownPieces(m_board.getPieces(color)),
+        m_enemyPieces(m_board.getPieces(getOppositeColor(color))),
+        m_occupancy(m_board.getOccupancy()),
+        m_generation(generation),
+        m_targets(generation == eMoveGeneration::Captures ? m_enemyPieces :
+                  generation == eMoveGeneration::Quiets ? ~m_occupancy : ~m_ownPieces),
+        m_moves(moves),
+        m_isStoppingAtFirstMove(false)
+    {
+    }
+
+    void LegalMoveGenerator::generate()
+    {
+        // only the king can get out of a double check
+        if(!m_legality.isOnDoubleCheck()) {
+            generatePawnMoves();
+            generatePieceMoves(Piece::Type::KNIGHT);
+            generatePieceMoves(Piece::Type::BISHOP);
+            generatePieceMoves(Piece::Type::ROOK);
+            generatePieceMoves(Piece::Type::QUEEN);
+        }
+        generateKingMoves();
+        generateCastlingMoves();
+    }
+
+    bool LegalMoveGenerator::hasAnyMove()
+    {
+        m_isStoppingAtFirstMove = true;
+
+        // the king is looked at first, it is the only one that can move on a double check.
+        // castling is skipped, when it is legal the king can also step next to the rook
+        generateKingMoves();
+        if(!m_legality.isOnDoubleCheck()) {
+            generatePieceMoves(Piece::Type::KNIGHT);
+            generatePieceMoves(Piece::Type::BISHOP);
+            generatePieceMoves(Piece::Type::ROOK);
+            generatePieceMoves(Piece::Type::QUEEN);
+            generatePawnMoves();
+        }
+
+        return !m_moves.empty();
+    }
+
+    void LegalMoveGenerator::generatePawnMoves()
+    {
+        const auto startingY = m_pawnDirection > 0 ? Chess::RANK_1 + 1 : Chess::RANK_8 - 1;
+        const auto& enPassantPosition = m_chessboard.getEnPassantPosition(getOppositeColor(m_color));
+
+        auto pawns = m_board.getPieces(m_color, Piece::Type::PAWN);
+        while(pawns && !isDone()) {
+            auto fromSquare = popFirstSquare(pawns);
+            auto x = getSquareX(fromSquare);
+            auto y = getSquareY(fromSquare);
+            auto yd = y + m_pawnDirection;
+
+            // a pawn waiting for its promotion has no moves
+            if(!isSquareValid(x, yd))
+                continue;
+
+            auto targetMask = m_legality.getTargetMask(fromSquare);
+
+            // single and double steps
+            auto toSquare = getSquare(x, yd);
+            if(m_board.isEmpty(toSquare) && m_generation != eMoveGeneration::Captures) {
+                if(targetMask & getSquareMask(toSquare))
+                    addPawnMove(fromSquare, toSquare);
+
+                auto doubleStepSquare = getSquare(x, yd + m_pawnDirection);
+                if(y == startingY && m_board.isEmpty(doubleStepSquare) && (targetMask & getSquareMask(doubleStepSquare)))
+                    addPawnMove(fromSquare, doubleStepSquare);
+            }
+
+            // captures
+            auto captures = getPawnAttacks(fromSquare, m_pawnDirection) & m_enemyPieces & m_targets & targetMask;
+            while(captures)
+                addPawnMove(fromSquare, popFirstSquare(captures));
+
+            // en passant, the pawn that moved two squares must be right next to this pawn
+            if(m_generation != eMoveGeneration::Quiets &&
+               enPassantPosition.y == y && (enPassantPosition.x == x - 1 || enPassantPosition.x == x + 1)) {
+                auto capturedSquare = getSquare(enPassantPosition.x, enPassantPosition.y);
+                auto enPassantSquare = getSquare(enPassantPosition.x, yd);
+                if(m_legality.isEnPassantLegal(fromSquare, enPassantSquare, capturedSquare))
+                    addMove(fromSquare, enPassantSquare, Move::eFlag::EnPassant);
+            }
+        }
+    }
+
+    void LegalMoveGenerator::generatePieceMoves(Piece::Type type)
+    {
+        auto pieces = m_board.getPieces(m_color, type);
+        while(pieces && !isDone()) {
+            auto fromSquare = popFirstSquare(pieces);
+            auto targets = getPieceAttacks(type, fromSquare) & m_targets & m_legality.getTargetMask(fromSquare);
+            while(targets)
+                addMove(fromSquare, popFirstSquare(targets));
+        }
+    }
+
+    void LegalMoveGenerator::generateKingMoves()
+    {
+        auto targets = getKingAttacks(m_kingSquare) & m_targets;
+        while(targets && !isDone()) {
+            auto toSquare = popFirstSquare(targets);
+            if(m_legality.isKingMoveLegal(toSquare))
+                addMove(m_kingSquare, toSquare);
+        }
+    }
+
+    void LegalMoveGenerator::generateCastlingMoves()
+    {
+        // castling:
+        // - neither the king nor the rook has moved, and there is nothing in between them
+        // - the king cannot be in check
+        // - nor can the king pass through any square that is under attack by an enemy piece,
+        // - or move to a square that would result in check.
+        if(m_generation == eMoveGeneration::Captures || !m_chessboard.getCastlingRights() || m_legality.isOnCheck())
+            return;
+
+        const auto xs = getSquareX(m_kingSquare);
+        const auto ys = getSquareY(m_kingSquare);
+        for(position_t inc_x : { -1, 1 }) {
+            // while the color has the right, the king and the rook are on their squares
+            const position_t rookX = inc_x < 0 ? 0 : static_cast<position_t>(BOARD_WIDTH - 1);
+            if(!m_chessboard.canCastle(m_color, rookX))
+                continue;
+
+            auto xf = xs + inc_x;
+            while(xf != rookX && m_board.isEmpty(getSquare(xf, ys)))
+                xf += inc_x;
+
+            if(xf != rookX || getDistance(m_kingSquare, getSquare(xf, ys)) <= 2)
+                continue;
+
+            assert(m_board.getPiece(getSquare(xf, ys)) == Piece(Piece::Type::ROOK, m_color));
+            auto toSquare = getSquare(xs + inc_x * 2, ys);
+            if(m_legality.isCastlingLegal(toSquare))
+                addMove(m_kingSquare, toSquare, Move::eFlag::Castling);
+        }
+    }
+
+    void LegalMoveGenerator::addMove(position_t fromSquare, position_t toSquare, Move::eFlag flag)
+    {
+        m_moves.emplace_back(fromSquare, toSquare, flag);
+    }
+
+    void LegalMoveGenerator::addPawnMove(position_t fromSquare, position_t toSquare)
+    {
+        auto yd = getSquareY(toSquare);
+        if(yd == Chess::RANK_1 || yd == Chess::RANK_8) {
+            m_moves.emplace_back(fromSquare, toSquare, Move::eFlag::Promotion, Piece::Type::QUEEN);
+            m_moves.emplace_back(fromSquare, toSquare, Move::eFlag::Promotion, Piece::Type::ROOK);
+            m_moves.emplace_back(fromSquare, toSquare, Move::eFlag::Promotion, Piece::Type::BISHOP);
+            m_moves.emplace_back(fromSquare, toSquare, Move::eFlag::Promotion, Piece::Type::KNIGHT);
+        } else {
+            addMove(fromSquare, toSquare);
+        }
+    }
+
+    bitboard_t LegalMoveGenerator::getPieceAttacks(Piece::Type type, position_t square) const
+    {
+        switch(type) {
+        case Piece::Type::KNIGHT:
+            return getKnightAttacks(square);
+        case Piece::Type::BISHOP:
+            return getBishopAttacks(square, m_occupancy);
+        case Piece::Type::ROOK:
+            return getRookAttacks(square, m_occupancy);
+        case Piece::Type::QUEEN:
+            return getQueenAttacks(square, m_occupancy);
+        default:
+            break;
+        }
+
+        assert(false);
+        return EMPTY_BITBOARD;
+    }
+}
+    void generateLegalMoves(Piece::eColor color, const Chess& chessboard, MoveList& moves, eMoveGeneration generation)
+    {
+        moves.clear();
+
+        LegalMoveGenerator generator(color, chessboard, moves, generation);
+        generator.generate();
+    }
+
+    bool hasAnyLegalMove(Piece::eColor color, const Chess& chessboard)
+    {
+        MoveList moves;
+
+        LegalMoveGenerator generator(color, chessboard, moves);
+        return generator.hasAnyMove();
+    }
+}
@@ -0,0 +1,40 @@
+/**********
+ *
+ *     This program is free software: you can redistribute it and/or modify
+ *     it under the terms of the GNU General Public License as published by
+ *     the Free Software Foundation, either version 3 of the License, or
+ *     (at your option) any later version.
+ * 
+ *     This program is distributed in the hope that it will be useful,
+ *     but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *     MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *     GNU General Public License for more details.
+ * 
+ *     You should have received a copy of the GNU General Public License
+ *     along with this program.  If not, see <https://www.gnu.org/licenses/>. 
+ *
+ **********/
+#pragma once
+
+// headers
+#include "../piece/piece.h"
+#include "moveList.h"
+
+namespace cchess
+{
+    class Chess;
+
+    // the moves to generate, captures include en passant, and quiet moves include castling
+    enum class eMoveGeneration : unsigned char
+    {
+        All,
+        Captures,
+        Quiets
+    };
+
+    // replaces the content of moves with every legal move of the given color
+    void generateLegalMoves(Piece::eColor color, const Chess& chessboard, MoveList& moves, eMoveGeneration generation = eMoveGeneration::All);
+
+    // stops at the first legal move found, to tell mates and stalemates apart from the rest
+    bool hasAnyLegalMove(Piece::eColor color, const Chess& chessboard);
+}
@@ -0,0 +1,130 @@
+/**********
+ *
+ *     This program is free software: you can redistribute it and/or modify
+ *     it under the terms of the GNU General Public License as published by
+ *     the Free Software Foundation, either version 3 of the License, or
+ *     (at your option) any later version.
+ * 
+ *     This program is distributed in the hope that it will be useful,
+ *     but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *     MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *     GNU General Public License for more details.
+ * 
+ *     You should have received a copy of the GNU General Public License
+ *     along with this program.  If not, see <https://www.gnu.org/licenses/>. 
+ *
+ **********/
+// headers
+#include <assert.h>
+#include "../board/attacks.h"
+#include "../chess.h"
+#include "moveLegality.h"
+
+namespace cchess
+{
+    MoveLegality::MoveLegality(Piece::eColor color, const Chess& chessboard) :
+        m_board(chessboard.getBoard()),
+        m_oppositeColor(getOppositeColor(color)),
+        m_pawnDirection(chessboard.getPawnDirection(color)),
+        m_whitePawnDirection(chessboard.getPawnDirection(Piece::eColor::white)),
+        m_kingSquare(getFirstSquare(m_board.getPieces(color, Piece::Type::KING))),
+        m_occupancy(m_board.getOccupancy()),
+        m_checkers(EMPTY_BITBOARD),
+        m_checkMask(~EMPTY_BITBOARD),
+        m_pinnedPieces(EMPTY_BITBOARD)
+    {
+        assert(m_board.getPieces(color, Piece::Type::KING));
+
+        const auto& board = m_board;
+        const auto enemyColor = m_oppositeColor;
+        const auto ownPieces = board.getPieces(color);
+        const auto enemyPieces = board.getPieces(enemyColor);
+        const auto enemyQueens = board.getPieces(enemyColor, Piece::Type::QUEEN);
+        const auto enemyBishops = board.getPieces(enemyColor, Piece::Type::BISHOP) | enemyQueens;
+        const auto enemyRooks = board.getPieces(enemyColor, Piece::Type::ROOK) | enemyQueens;
+
+        m_checkers = (getPawnAttacks(m_kingSquare, m_pawnDirection) & board.getPieces(enemyColor, Piece::Type::PAWN)) |
+                     (getKnightAttacks(m_kingSquare) & board.getPieces(enemyColor, Piece::Type::KNIGHT));
+
+        // look through our own pieces, a slider with exactly one of our pieces in
+        // between pins it, and a slider with nothing in between checks the king
+        auto snipers = (getBishopAttacks(m_kingSquare, enemyPieces) & enemyBishops) |
+                       (getRookAttacks(m_kingSquare, enemyPieces) & enemyRooks);
+        while(snipers) {
+            auto sniperSquare = popFirstSquare(snipers);
+            auto between = getBetweenSquares(m_kingSquare, sniperSquare) & m_occupancy;
+            if(!between)
+                m_checkers |= getSquareMask(sniperSquare);
+            else if(getPopulationCount(between) == 1)
+                m_pinnedPieces |= between & ownPieces;
+        }
+
+        // when on check, a move has to capture the checker or block it
+        if(m_checkers) {
+            if(isOnDoubleCheck()) {
+                m_checkMask = EMPTY_BITBOARD;
+            } else {
+                auto checkerSquare = getFirstSquare(m_checkers);
+                m_checkMask = m_checkers | getBetweenSquares(m_kingSquare, checkerSquare);
+            }
+        }
+    }
+
+    bitboard_t MoveLegality::getTargetMask(position_t fromSquare) const
+    {
+        // a pinned piece can only move along the pin
+        if(m_pinnedPieces & getSquareMask(fromSquare))
+            return m_checkMask & getLineSquares(m_kingSquare, fromSquare);
+
+        return m_checkMask;
+    }
+
+    bool MoveLegality::isKingMoveLegal(position_t toSquare) const
+    {
+        // the king is taken off the board, so it cannot hide behind itself from a slider
+        return !isSquareAttacked(toSquare, m_occupancy & ~getSquareMask(m_kingSquare));
+    }
+
+    bool MoveLegality::isCastlingLegal(position_t toSquare) const
+    {
+        if(isOnCheck())
+            return false;
+
+        // the king passes through the square in between
+        auto middleSquare = (m_kingSquare + toSquare) / 2;
+        return !isSquareAttacked(middleSquare, m_occupancy) && isKingMoveLegal(toSquare);
+    }
+
+    bool MoveLegality::isEnPassantLegal(position_t fromSquare, position_t toSquare, position_t capturedSquare) const
+    {
+        // two pawns leave the same rank at once, which masks can't describe, so
+        // play it on the occupancy instead
+        auto capturedMask = getSquareMask(capturedSquare);
+        auto occupancy = (m_occupancy & ~getSquareMask(fromSquare) & ~capturedMask) | getSquareMask(toSquare);
+        return !isSquareAttacked(m_kingSquare, occupancy & ~capturedMask);
+    }
+
+    bool MoveLegality::isLegal(Move move) const
+    {
+        auto fromSquare = move.getFrom();
+        auto toSquare = move.getTo();
+        switch(move.getFlag()) {
+        case Move::eFlag::Castling:
+            return isCastlingLegal(toSquare);
+        case Move::eFlag::EnPassant:
+            return isEnPassantLegal(fromSquare, toSquare, getCapturedSquare(move));
+        default:
+            break;
+        }
+
+        if(fromSquare == m_kingSquare)
+            return isKingMoveLegal(toSquare);
+
+        return getTargetMask(fromSquare) & getSquareMask(toSquare);
+    }
+
+    bool MoveLegality::isSquareAttacked(position_t square, bitboard_t occupancy) const
+    {
+        return getAttackersTo(m_board, square, occupancy, m_whitePawnDirection) & m_board.getPieces(m_oppositeColor);
+    }
+}
@@ -0,0 +1,64 @@
+/**********
+ *
+ *     This program is free software: you can redistribute it and/or modify
+ *     it under the terms of the GNU General Public License as published by
+ *     the Free Software Foundation, either version 3 of the License, or
+ *     (at your option) any later version.
+ * 
+ *     This program is distributed in the hope that it will be useful,
+ *     but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *     MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *     GNU General Public License for more details.
+ * 
+ *     You should have received a copy of the GNU General Public License
+ *     along with this program.  If not, see <https://www.gnu.org/licenses/>. 
+ *
+ **********/
+#pragma once
+
+// headers
+#include "../board/bitboard.h"
+#include "../piece/piece.h"
+#include "../types.h"
+#include "move.h"
+
+namespace cchess
+{
+    class Board;
+    class Chess;
+
+    // the checkers, pinned pieces and evasion squares of a color, computed once
+    // per position, so the legality of a move is decided without playing it
+    class MoveLegality
+    {
+    public:
+        MoveLegality(Piece::eColor color, const Chess& chessboard);
+
+        bool isOnCheck() const { return m_checkers != EMPTY_BITBOARD; }
+        bool isOnDoubleCheck() const { return getPopulationCount(m_checkers) > 1; }
+        bitboard_t getCheckers() const { return m_checkers; }
+        bitboard_t getPinnedPieces() const { return m_pinnedPieces; }
+        position_t getKingSquare() const { return m_kingSquare; }
+
+        // squares a piece other than the king can go to without leaving the king in check
+        bitboard_t getTargetMask(position_t fromSquare) const;
+
+        bool isKingMoveLegal(position_t toSquare) const;
+        bool isCastlingLegal(position_t toSquare) const;
+        bool isEnPassantLegal(position_t fromSquare, position_t toSquare, position_t capturedSquare) const;
+        bool isLegal(Move move) const;
+
+        bool isSquareAttacked(position_t square, bitboard_t occupancy) const;
+
+    private:
+        const Board&    m_board;
+        Piece::eColor   m_oppositeColor;
+        position_t      m_pawnDirection;
+        position_t      m_whitePawnDirection;
+        position_t      m_kingSquare;
+        bitboard_t      m_occupancy;
+        bitboard_t      m_checkers;
+        bitboard_t      m_checkMask;
+        bitboard_t      m_pinnedPieces;
+    };
+}
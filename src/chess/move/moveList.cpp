@@ -0,0 +1,38 @@
+/**********
+ *
+ *     This program is free software: you can redistribute it and/or modify
+ *     it under the terms of the GNU General Public License as published by
+ *     the Free Software Foundation, either version 3 of the License, or
+ *     (at your option) any later version.
+ * 
+ *     This program is distributed in the hope that it will be useful,
+ *     but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *     MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *     GNU General Public License for more details.
+ * 
+ *     You should have received a copy of the GNU General Public License
+ *     along with this program.  If not, see <https://www.gnu.org/licenses/>. 
+ *
+ **********/
+// headers
+#include <assert.h>
+#include <utility>
+#include "moveList.h"
+
+namespace cchess
+{
+    Move pickBestMove(ScoredMoveList& moves, std::size_t index)
+    {
+        assert(index < moves.size());
+
+        // a selection step, so only the moves that are actually tried get sorted
+        auto bestIndex = index;
+        for(std::size_t i = index + 1, i_size = moves.size(); i < i_size; ++i) {
+            if(moves[i].score > moves[bestIndex].score)
+                bestIndex = i;
+        }
+        std::swap(moves[index], moves[bestIndex]);
+
+        return moves[index].move;
+    }
+}
@@ -0,0 +1,41 @@
+/**********
+ *
+ *     This program is free software: you can redistribute it and/or modify
+ *     it under the terms of the GNU General Public License as published by
+ *     the Free Software Foundation, either version 3 of the License, or
+ *     (at your option) any later version.
+ * 
+ *     This program is distributed in the hope that it will be useful,
+ *     but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *     MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *     GNU General Public License for more details.
+ * 
+ *     You should have received a copy of the GNU General Public License
+ *     along with this program.  If not, see <https://www.gnu.org/licenses/>. 
+ *
+ **********/
+#pragma once
+
+// headers
+#include "../3rdparty/container/static_vector.h"
+#include "move.h"
+
+namespace cchess
+{
+    using MoveList = mar::container::static_vector<Move, MAX_MOVES>;
+
+    // a move with the score used to order it
+    struct ScoredMove
+    {
+        ScoredMove() : score(0) {}
+        ScoredMove(Move move_, int score_) : move(move_), score(score_) {}
+
+        Move    move;
+        int     score;
+    };
+
+    using ScoredMoveList = mar::container::static_vector<ScoredMove, MAX_MOVES>;
+
+    // moves the best scored move starting at index to index, and returns it
+    Move pickBestMove(ScoredMoveList& moves, std::size_t index);
+}
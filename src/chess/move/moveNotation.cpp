@@ -0,0 +1,123 @@
+/**********
+ *
+ *     This program is free software: you can redistribute it and/or modify
+ *     it under the terms of the GNU General Public License as published by
+ *     the Free Software Foundation, either version 3 of the License, or
+ *     (at your option) any later version.
+ * 
+ *     This program is distributed in the hope that it will be useful,
+ *     but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *     MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *     GNU General Public License for more details.
+ * 
+ *     You should have received a copy of the GNU General Public License
+ *     along with this program.  If not, see <https://www.gnu.org/licenses/>. 
+ *
+ **********/
+// headers
+#include <assert.h>
+#include <cctype>
+#include "../chess.h"
+#include "moveNotation.h"
+
+namespace cchess
+{
+namespace
+{
+    bool isAnnotation(char character)
+    {
+        return character == '+' || character == '#' || character == '!' || character == '?';
+    }
+
+    bool isFile(char character)
+    {
+        return character >= 'a' && character < static_cast<char>('a' + BOARD_WIDTH);
+    }
+
+    bool isRank(char character)
+    {
+        return character >= '1' && character < static_cast<char>('1' + BOARD_HEIGHT);
+    }
+
+    Move findCastlingMove(bool isKingside, const MoveList& legalMoves)
+    {
+        // the kingside rook is on the h file
+        for(auto move : legalMoves) {
+            if(move.getFlag() == Move::eFlag::Castling && (getSquareX(move.getTo()) > getSquareX(move.getFrom())) == isKingside)
+                return move;
+        }
+
+        return Move();
+    }
+}
+    Move findSANMove(std::string_view san, const Chess& chessboard, const MoveList& legalMoves)
+    {
+        // check, mate and annotation marks don't change the move
+        while(!san.empty() && isAnnotation(san.back()))
+            san.remove_suffix(1);
+
+        if(san == "O-O" || san == "0-0")
+            return findCastlingMove(true, legalMoves);
+        if(san == "O-O-O" || san == "0-0-0")
+            return findCastlingMove(false, legalMoves);
+
+        auto typeToPromoteTo = Piece::Type::EMPTY;
+        if(!san.empty() && std::isupper(static_cast<unsigned char>(san.back()))) {
+            typeToPromoteTo = getTypeOfCharacter(san.back());
+            if(typeToPromoteTo == Piece::Type::EMPTY || typeToPromoteTo == Piece::Type::PAWN || typeToPromoteTo == Piece::Type::KING)
+                return Move();
+
+            san.remove_suffix(1);
+            if(!san.empty() && san.back() == '=')
+                san.remove_suffix(1);
+        }
+
+        // the destination is always written in full
+        if(san.size() < 2 || !isFile(san[san.size() - 2]) || !isRank(san.back()))
+            return Move();
+        const auto toSquare = getSquare(san[san.size() - 2] - 'a', '8' - san.back());
+        san.remove_suffix(2);
+
+        // a piece letter, or a pawn
+        auto type = Piece::Type::PAWN;
+        if(!san.empty() && std::isupper(static_cast<unsigned char>(san.front()))) {
+            type = getTypeOfCharacter(san.front());
+            if(type == Piece::Type::EMPTY)
+                return Move();
+            san.remove_prefix(1);
+        }
+
+        // what is left is the file and/or rank of the piece, and the capture mark
+        position_t fromX = -1;
+        position_t fromY = -1;
+        for(auto character : san) {
+            if(isFile(character))
+                fromX = character - 'a';
+            else if(isRank(character))
+                fromY = '8' - character;
+            else if(character != 'x' && character != ':')
+                return Move();
+        }
+
+        const auto& board = chessboard.getBoard();
+        Move ret;
+        for(auto move : legalMoves) {
+            const auto fromSquare = move.getFrom();
+            if(move.getTo() != toSquare || board.getPiece(fromSquare).getType() != type)
+                continue;
+            if((fromX >= 0 && getSquareX(fromSquare) != fromX) || (fromY >= 0 && getSquareY(fromSquare) != fromY))
+                continue;
+
+            // a pawn reaching the last rank has to say what it promotes to
+            auto isPromotion = move.getFlag() == Move::eFlag::Promotion;
+            if(isPromotion != (typeToPromoteTo != Piece::Type::EMPTY) || (isPromotion && move.getTypeToPromoteTo() != typeToPromoteTo))
+                continue;
+
+            if(!ret.isEmpty())
+                return Move();
+            ret = move;
+        }
+
+        return ret;
+    }
+}
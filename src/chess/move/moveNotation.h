@@ -0,0 +1,31 @@
+/**********
+ *
+ *     This program is free software: you can redistribute it and/or modify
+ *     it under the terms of the GNU General Public License as published by
+ *     the Free Software Foundation, either version 3 of the License, or
+ *     (at your option) any later version.
+ * 
+ *     This program is distributed in the hope that it will be useful,
+ *     but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *     MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *     GNU General Public License for more details.
+ * 
+ *     You should have received a copy of the GNU General Public License
+ *     along with this program.  If not, see <https://www.gnu.org/licenses/>. 
+ *
+ **********/
+#pragma once
+
+// headers
+#include <string_view>
+#include "moveList.h"
+
+namespace cchess
+{
+    class Chess;
+
+    // standard algebraic notation, ex: e4, Nbd7, exd8=Q+, O-O.
+    // the squares are read with white on the bottom, like convertStringPositionToInt.
+    // returns the move of legalMoves it stands for, empty when no move or more than one matches
+    Move findSANMove(std::string_view san, const Chess& chessboard, const MoveList& legalMoves);
+}
@@ -0,0 +1,178 @@
+/**********
+ *
+ *     This program is free software: you can redistribute it and/or modify
+ *     it under the terms of the GNU General Public License as published by
+ *     the Free Software Foundation, either version 3 of the License, or
+ *     (at your option) any later version.
+ * 
+ *     This program is distributed in the hope that it will be useful,
+ *     but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *     MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *     GNU General Public License for more details.
+ * 
+ *     You should have received a copy of the GNU General Public License
+ *     along with this program.  If not, see <https://www.gnu.org/licenses/>. 
+ *
+ **********/
+// headers
+#include <assert.h>
+#include "../chess.h"
+#include "moveGenerator.h"
+#include "movePicker.h"
+
+namespace cchess
+{
+namespace
+{
+    // indexed by the type index of the piece
+    static constexpr int PIECE_VALUES[Piece::NUMBER_OF_TYPE] = { 100, 300, 300, 500, 900, 10000 };
+
+    int getPieceValue(Piece::Type type)
+    {
+        return PIECE_VALUES[getTypeIndex(type)];
+    }
+
+    Piece::Type getCapturedType(Move move, const Board& board)
+    {
+        return move.getFlag() == Move::eFlag::EnPassant ? Piece::Type::PAWN : board.getPiece(move.getTo()).getType();
+    }
+}
+    MovePicker::MovePicker(const Chess& chessboard, Move hashMove, Move firstKiller, Move secondKiller) :
+        m_chessboard(chessboard),
+        m_color(chessboard.getCurrentColorsTurn()),
+        m_stage(eStage::HashMove),
+        m_hashMove(hashMove),
+        m_killers{ firstKiller, secondKiller },
+        m_killerIndex(0),
+        m_index(0),
+        m_losingCaptureIndex(0)
+    {
+    }
+
+    Move MovePicker::getNextMove()
+    {
+        switch(m_stage) {
+        case eStage::HashMove:
+            m_stage = eStage::GenerateCaptures;
+            if(m_chessboard.isMoveLegal(m_hashMove))
+                return m_hashMove;
+            // fall through
+        case eStage::GenerateCaptures:
+            generateCaptures();
+            m_stage = eStage::WinningCaptures;
+            // fall through
+        case eStage::WinningCaptures:
+            while(m_index < m_moves.size()) {
+                auto move = pickBestMove(m_moves, m_index++);
+                if(move == m_hashMove)
+                    continue;
+
+                if(isLosingCapture(move)) {
+                    m_losingCaptures.push_back(move);
+                    continue;
+                }
+
+                return move;
+            }
+            m_stage = eStage::Killers;
+            // fall through
+        case eStage::Killers:
+            while(m_killerIndex < NUMBER_OF_KILLERS) {
+                auto index = m_killerIndex++;
+                auto killer = m_killers[index];
+
+                // a killer is a quiet move, a capture is already picked with the others
+                const auto& board = m_chessboard.getBoard();
+                if(killer.isEmpty() || !board.isEmpty(killer.getTo()) || killer.getFlag() == Move::eFlag::EnPassant)
+                    continue;
+
+                if(killer == m_hashMove || (index > 0 && killer == m_killers[0]))
+                    continue;
+
+                if(m_chessboard.isMoveLegal(killer))
+                    return killer;
+            }
+            m_stage = eStage::GenerateQuiets;
+            // fall through
+        case eStage::GenerateQuiets:
+            generateQuiets();
+            m_stage = eStage::Quiets;
+            // fall through
+        case eStage::Quiets:
+            while(m_index < m_moves.size()) {
+                auto move = pickBestMove(m_moves, m_index++);
+                if(!isAlreadyPicked(move))
+                    return move;
+            }
+            m_stage = eStage::LosingCaptures;
+            // fall through
+        case eStage::LosingCaptures:
+            if(m_losingCaptureIndex < m_losingCaptures.size())
+                return m_losingCaptures[m_losingCaptureIndex++];
+
+            m_stage = eStage::Done;
+            // fall through
+        case eStage::Done:
+            break;
+        }
+
+        return Move();
+    }
+
+    void MovePicker::generateCaptures()
+    {
+        MoveList moves;
+        generateLegalMoves(m_color, m_chessboard, moves, eMoveGeneration::Captures);
+
+        // the most valuable victim first, and the least valuable attacker among those
+        const auto& board = m_chessboard.getBoard();
+        m_moves.clear();
+        m_index = 0;
+        for(auto move : moves) {
+            auto score = getPieceValue(getCapturedType(move, board)) * Piece::NUMBER_OF_TYPE - board.getPiece(move.getFrom()).getTypeIndex();
+            if(move.getFlag() == Move::eFlag::Promotion)
+                score += getPieceValue(move.getTypeToPromoteTo()) * Piece::NUMBER_OF_TYPE;
+
+            m_moves.emplace_back(move, score);
+        }
+    }
+
+    void MovePicker::generateQuiets()
+    {
+        MoveList moves;
+        generateLegalMoves(m_color, m_chessboard, moves, eMoveGeneration::Quiets);
+
+        // nothing tells the quiet moves apart yet, but the promotions
+        m_moves.clear();
+        m_index = 0;
+        for(auto move : moves)
+            m_moves.emplace_back(move, move.getFlag() == Move::eFlag::Promotion ? getPieceValue(move.getTypeToPromoteTo()) : 0);
+    }
+
+    bool MovePicker::isLosingCapture(Move move) const
+    {
+        // a piece that takes a more valuable or equal one can't lose material
+        const auto& board = m_chessboard.getBoard();
+        auto attackerType = board.getPiece(move.getFrom()).getType();
+        if(getPieceValue(attackerType) <= getPieceValue(getCapturedType(move, board)))
+            return false;
+
+        // otherwise it loses the difference when the other color can take it back
+        auto occupancy = board.getOccupancy() & ~getSquareMask(move.getFrom());
+        return m_chessboard.getAttackersTo(move.getTo(), occupancy) & board.getPieces(getOppositeColor(m_color));
+    }
+
+    bool MovePicker::isAlreadyPicked(Move move) const
+    {
+        // a quiet killer is legal whenever it is generated, so it has been picked on its stage
+        if(move == m_hashMove)
+            return true;
+
+        for(auto killer : m_killers) {
+            if(move == killer)
+                return true;
+        }
+
+        return false;
+    }
+}
@@ -0,0 +1,75 @@
+/**********
+ *
+ *     This program is free software: you can redistribute it and/or modify
+ *     it under the terms of the GNU General Public License as published by
+ *     the Free Software Foundation, either version 3 of the License, or
+ *     (at your option) any later version.
+ * 
+ *     This program is distributed in the hope that it will be useful,
+ *     but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *     MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *     GNU General Public License for more details.
+ * 
+ *     You should have received a copy of the GNU General Public License
+ *     along with this program.  If not, see <https://www.gnu.org/licenses/>. 
+ *
+ **********/
+#pragma once
+
+// headers
+#include "../piece/piece.h"
+#include "moveList.h"
+
+namespace cchess
+{
+    class Chess;
+
+    // yields the legal moves of the side to move one stage at a time, best first.
+    // a stage is only generated once the previous ones ran out, since a search
+    // usually cuts off on the first few moves and never asks for the rest
+    class MovePicker
+    {
+    public:
+        static constexpr std::size_t NUMBER_OF_KILLERS = 2;
+
+        enum class eStage : unsigned char
+        {
+            HashMove,
+            GenerateCaptures,
+            WinningCaptures,
+            Killers,
+            GenerateQuiets,
+            Quiets,
+            LosingCaptures,
+            Done
+        };
+
+        // the hash move and the killers can come from another position, they are only tried when legal here
+        MovePicker(const Chess& chessboard, Move hashMove = Move(), Move firstKiller = Move(), Move secondKiller = Move());
+
+        // an empty move once every move has been picked
+        Move getNextMove();
+
+        eStage getStage() const { return m_stage; }
+
+    private:
+        void generateCaptures();
+        void generateQuiets();
+
+        bool isLosingCapture(Move move) const;
+        bool isAlreadyPicked(Move move) const;
+
+        const Chess&    m_chessboard;
+        Piece::eColor   m_color;
+        eStage          m_stage;
+
+        Move            m_hashMove;
+        Move            m_killers[NUMBER_OF_KILLERS];
+        std::size_t     m_killerIndex;
+
+        ScoredMoveList  m_moves;
+        std::size_t     m_index;
+        MoveList        m_losingCaptures;   // put aside while the winning captures are picked
+        std::size_t     m_losingCaptureIndex;
+    };
+}
@@ -16,50 +16,24 @@
  **********/
 // headers
 #include <assert.h>
+#include <cctype>
 #include "piece.h"
 
 namespace cchess
 {
     Piece::Piece() :
-        m_type(Type::EMPTY),
-        m_color(eColor::white),
-        m_hasMoved(false),
-        m_id(0)
+        m_code(EMPTY_CODE)
     {
     }
 
-    Piece::Piece(Type type, unsigned char id, eColor color) :
-        m_type(type),
-        m_color(color),
-        m_hasMoved(false),
-        m_id(id)
+    Piece::Piece(Type type, eColor color) :
+        m_code(static_cast<unsigned char>(cchess::getTypeIndex(type) | (getColorIndex(color) << COLOR_SHIFT)))
     {
-        assert(m_type == Type::PAWN ||
-               m_type == Type::KNIGHT ||
-               m_type == Type::BISHOP ||
-               m_type == Type::ROOK ||
-               m_type == Type::QUEEN ||
-               m_type == Type::KING);
-    }
-
-    void Piece::setMovedFlag()
-    {
-//        if(!hasMoved())
-            m_hasMoved = true;
-    }
-
-    void Piece::resetMovedFlag()
-    {
-//        if(hasMoved())
-            m_hasMoved = false;
     }
 
     bool operator==(const Piece& lhs, const Piece& rhs)
     {
-        return lhs.m_type == rhs.m_type &&
-               lhs.m_color == rhs.m_color &&
-               lhs.m_hasMoved == rhs.m_hasMoved &&
-               lhs.m_id == rhs.m_id;
+        return lhs.m_code == rhs.m_code;
     }
 
     bool operator!=(const Piece& lhs, const Piece& rhs)
@@ -72,14 +46,25 @@ namespace cchess
         return static_cast<char>(piece.getType());
     }
 
-    Piece::eColor getOppositeColor(Piece::eColor color)
+    Piece::Type getTypeOfCharacter(char character)
     {
-        return color == Piece::eColor::white ? Piece::eColor::black : Piece::eColor::white;
-    }
+        switch(std::toupper(static_cast<unsigned char>(character))) {
+        case 'P':
+            return Piece::Type::PAWN;
+        case 'N':
+            return Piece::Type::KNIGHT;
+        case 'B':
+            return Piece::Type::BISHOP;
+        case 'R':
+            return Piece::Type::ROOK;
+        case 'Q':
+            return Piece::Type::QUEEN;
+        case 'K':
+            return Piece::Type::KING;
+        default:
+            break;
+        }
 
-    std::underlying_type_t<Piece::eColor> getColorIndex(Piece::eColor color)
-    {
-        using underlying_color_type = std::underlying_type_t<Piece::eColor>;
-        return static_cast<underlying_color_type>(color);
+        return Piece::Type::EMPTY;
     }
 }
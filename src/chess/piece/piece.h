@@ -17,7 +17,9 @@
 #pragma once
 
 // headers
+#include <assert.h>
 #include <locale>
+#include <type_traits>
 
 namespace cchess
 {
@@ -28,6 +30,7 @@ namespace cchess
         using color_index_type = std::underlying_type_t<eColor>;
 
         static constexpr unsigned char NUMBER_OF_COLOR = 2;
+        static constexpr unsigned char NUMBER_OF_TYPE = 6;
 
         enum class Type : char {
             EMPTY = ' ',
@@ -47,31 +50,77 @@ namespace cchess
 //        static constexpr auto KING = 'K';
 
         Piece();
-        Piece(Type type, unsigned char id, eColor color);
+        Piece(Type type, eColor color);
 
-        bool isEmpty() const { return m_type == Type::EMPTY; }
+        bool isEmpty() const { return m_code == EMPTY_CODE; }
 
-        Type getType() const { return m_type; }
-        eColor getColor() const { return m_color; }
-        bool hasMoved() const { return m_hasMoved; }
-        unsigned char getId() const { return m_id; }
-
-        void setMovedFlag();
-        void resetMovedFlag();
+        Type getType() const { return INDEX_TO_TYPE[getTypeIndex()]; }
+        eColor getColor() const { return static_cast<eColor>(m_code >> COLOR_SHIFT); }
+        unsigned char getTypeIndex() const { return m_code & TYPE_MASK; }
 
     private:
         friend bool operator==(const Piece& lhs, const Piece& rhs);
 
-        Type            m_type;
-        eColor          m_color;
-        bool            m_hasMoved;
-        unsigned char   m_id;
+        // a piece is a single byte, the type index in the low bits and the color above it
+        static constexpr unsigned char COLOR_SHIFT = 3;
+        static constexpr unsigned char TYPE_MASK = (1 << COLOR_SHIFT) - 1;
+        static constexpr unsigned char EMPTY_CODE = TYPE_MASK;
+
+        static constexpr Type INDEX_TO_TYPE[] =
+        {
+            Type::PAWN,
+            Type::KNIGHT,
+            Type::BISHOP,
+            Type::ROOK,
+            Type::QUEEN,
+            Type::KING,
+            Type::EMPTY,
+            Type::EMPTY
+        };
+
+        unsigned char   m_code;
     };
 
+    static_assert(sizeof(Piece) == 1, "a piece must fit in a byte");
+
     bool operator==(const Piece& lhs, const Piece& rhs);
     bool operator!=(const Piece& lhs, const Piece& rhs);
 
     char getCharacterOfPiece(Piece piece);
-    Piece::eColor getOppositeColor(Piece::eColor color);
-    std::underlying_type_t<Piece::eColor> getColorIndex(Piece::eColor color);
+    // the inverse of getCharacterOfPiece for either case, EMPTY when the character is not a piece
+    Piece::Type getTypeOfCharacter(char character);
+
+    inline constexpr Piece::eColor getOppositeColor(Piece::eColor color)
+    {
+        return color == Piece::eColor::white ? Piece::eColor::black : Piece::eColor::white;
+    }
+
+    inline constexpr std::underlying_type_t<Piece::eColor> getColorIndex(Piece::eColor color)
+    {
+        return static_cast<std::underlying_type_t<Piece::eColor>>(color);
+    }
+
+    inline constexpr unsigned char getTypeIndex(Piece::Type type)
+    {
+        // dense index of the piece type, used to index the per type tables
+        switch(type) {
+        case Piece::Type::PAWN:
+            return 0;
+        case Piece::Type::KNIGHT:
+            return 1;
+        case Piece::Type::BISHOP:
+            return 2;
+        case Piece::Type::ROOK:
+            return 3;
+        case Piece::Type::QUEEN:
+            return 4;
+        case Piece::Type::KING:
+            return 5;
+        default:
+            break;
+        }
+
+        assert(false);
+        return 0;
+    }
 }
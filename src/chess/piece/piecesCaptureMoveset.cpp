@@ -16,69 +16,60 @@
  **********/
 // headers
 #include <assert.h>
-#include <unordered_map>
+#include "../board/attacks.h"
 #include "../chess.h"
 #include "piecesMoveset.h"
 #include "piecesCaptureMoveset.h"
 
 namespace cchess
 {
-    static std::tuple<bool, position_t, position_t> isDefaultCaptureValid(Piece piece, position_t xs, position_t ys, position_t xd, position_t yd, const Chess& chessboard)
+    static Move isDefaultCaptureValid(Piece piece, position_t xs, position_t ys, position_t xd, position_t yd, const Chess& chessboard)
     {
-        return { isMoveValid(piece,xs, ys, xd, yd, chessboard).size(), xd, yd };
+        return isMoveValid(piece, xs, ys, xd, yd, chessboard);
     }
 
-    static std::tuple<bool, position_t, position_t> isPawnCaptureValid(Piece piece, position_t xs, position_t ys, position_t xd, position_t yd, const Chess& chessboard)
+    static Move isPawnCaptureValid(Piece piece, position_t xs, position_t ys, position_t xd, position_t yd, const Chess& chessboard)
     {
-        auto color = piece.getColor();
-        auto pieceMoveDirection = chessboard.getPawnDirection(color);
-        if(yd == ys + pieceMoveDirection) {
-            auto dx = xd - xs;
-            auto adx = std::abs(dx);
-            if(adx == 1)
-                return { true, xd, yd };
-        }
+        auto pieceMoveDirection = chessboard.getPawnDirection(piece.getColor());
+        if(getPawnAttacks(getSquare(xs, ys), pieceMoveDirection) & getSquareMask(getSquare(xd, yd)))
+            return Move(getSquare(xs, ys), getSquare(xd, yd));
 
-        return { false, -1, -1 };
+        return Move();
     }
 
-    std::tuple<bool, position_t, position_t> isPawnSpecialCaptureValid(Piece piece, position_t xs, position_t ys, position_t xd, position_t yd, const Chess& chessboard)
+    Move isPawnSpecialCaptureValid(Piece piece, position_t xs, position_t ys, position_t xd, position_t yd, const Chess& chessboard)
     {
         auto color = piece.getColor();
         auto pieceMoveDirection = chessboard.getPawnDirection(color);
-        if(yd == ys + pieceMoveDirection) {
-            auto dx = xd - xs;
-            auto adx = std::abs(dx);
-            if(adx == 1) {
-                const auto& enPassantPosition = chessboard.getEnPassantPosition(getOppositeColor(color));
-                auto xc = enPassantPosition.x;
-                auto yc = enPassantPosition.y;
-                if(xc == xd && yc == ys)
-                    return { true, xc, yc };
-            }
+        if(getPawnAttacks(getSquare(xs, ys), pieceMoveDirection) & getSquareMask(getSquare(xd, yd))) {
+            const auto& enPassantPosition = chessboard.getEnPassantPosition(getOppositeColor(color));
+            auto xc = enPassantPosition.x;
+            auto yc = enPassantPosition.y;
+            if(xc == xd && yc == ys)
+                return Move(getSquare(xs, ys), getSquare(xd, yd), Move::eFlag::EnPassant);
         }
 
-        return { false, -1, -1 };
+        return Move();
     }
 
-    std::tuple<bool, position_t, position_t> isCaptureValid(Piece piece, position_t xs, position_t ys, position_t xd, position_t yd, const Chess& chessboard)
+    Move isCaptureValid(Piece piece, position_t xs, position_t ys, position_t xd, position_t yd, const Chess& chessboard)
     {
-        using function_ptr_type = std::tuple<bool, position_t, position_t>(*)(Piece piece, position_t xs, position_t ys, position_t xd, position_t yd, const Chess& chessboard);
-        static const std::unordered_map<Piece::Type, function_ptr_type> TYPE_TO_CAPTURE =
+        using function_ptr_type = Move(*)(Piece piece, position_t xs, position_t ys, position_t xd, position_t yd, const Chess& chessboard);
+        // indexed by the type index of the piece
+        static constexpr function_ptr_type TYPE_TO_CAPTURE[Piece::NUMBER_OF_TYPE] =
         {
-            { Piece::Type::PAWN, &isPawnCaptureValid },
-            { Piece::Type::KNIGHT, &isDefaultCaptureValid },
-            { Piece::Type::BISHOP, &isDefaultCaptureValid },
-            { Piece::Type::ROOK, &isDefaultCaptureValid },
-            { Piece::Type::QUEEN, &isDefaultCaptureValid },
-            { Piece::Type::KING, &isDefaultCaptureValid },
+            &isPawnCaptureValid,
+            &isDefaultCaptureValid,
+            &isDefaultCaptureValid,
+            &isDefaultCaptureValid,
+            &isDefaultCaptureValid,
+            &isDefaultCaptureValid
         };
 
         assert(!piece.isEmpty());
         if(isSelfMove(xs, ys, xd, yd))
-            return { false, -1, -1 };
+            return Move();
 
-        assert(TYPE_TO_CAPTURE.find(piece.getType()) != TYPE_TO_CAPTURE.end()); // if this spits an erro, we made a mistake in make the piece
-        return (*TYPE_TO_CAPTURE.at(piece.getType()))(piece, xs, ys, xd, yd, chessboard);
+        return (*TYPE_TO_CAPTURE[piece.getTypeIndex()])(piece, xs, ys, xd, yd, chessboard);
     }
 }
@@ -17,13 +17,13 @@
 #pragma once
 
 // headers
-#include <tuple>
+#include "../move/move.h"
 #include "../types.h"
 #include "piece.h"
 
 namespace cchess
 {
     class Chess;
-    std::tuple<bool, position_t, position_t> isPawnSpecialCaptureValid(Piece piece, position_t xs, position_t ys, position_t xd, position_t yd, const Chess& chessboard);
-    std::tuple<bool, position_t, position_t> isCaptureValid(Piece piece, position_t xs, position_t ys, position_t xd, position_t yd, const Chess& chessboard);
+    Move isPawnSpecialCaptureValid(Piece piece, position_t xs, position_t ys, position_t xd, position_t yd, const Chess& chessboard);
+    Move isCaptureValid(Piece piece, position_t xs, position_t ys, position_t xd, position_t yd, const Chess& chessboard);
 }
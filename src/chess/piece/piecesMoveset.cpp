@@ -15,7 +15,7 @@
  *
  **********/
 // headers
-#include <unordered_map>
+#include "../board/attacks.h"
 #include "../chess.h"
 #include "piecesMoveset.h"
 
@@ -25,190 +25,114 @@ namespace detail
 {
     static bool isBishopMoveValid(position_t xs, position_t ys, position_t xd, position_t yd, Piece::eColor, const Chess& chessboard)
     {
-        auto dx = xd - xs;
-        auto dy = yd - ys;
-        auto adx = std::abs(dx);
-        auto ady = std::abs(dy);
-        if(adx == ady) {
-            auto x = xs;
-            auto y = ys;
-            if(adx && ady) {
-                auto inc_x = dx / adx;
-                auto inc_y = dy / ady;
-
-                for(position_t i = 0; i < adx - 1; ++i) {
-                    x += inc_x;
-                    y += inc_y;
-                    auto piece = chessboard.getBoardPiece(x, y);
-                    if(!piece.isEmpty())
-                        return false;
-                }
-            }
-
-            return true;
-        }
-
-        return false;
+        auto attacks = getBishopAttacks(getSquare(xs, ys), chessboard.getBoard().getOccupancy());
+        return attacks & getSquareMask(getSquare(xd, yd));
     }
 
     bool isRookMoveValid(position_t xs, position_t ys, position_t xd, position_t yd, Piece::eColor, const Chess& chessboard)
     {
-        auto dx = xd - xs;
-        auto dy = yd - ys;
-        auto adx = std::abs(dx);
-        auto ady = std::abs(dy);
-        if(xs == xd) {
-            auto x = xs;
-            auto y = ys;
-            if(ady) {
-                auto inc_y = dy / ady;
-                for(position_t i = 0; i < ady - 1; ++i) {
-                    y += inc_y;
-                    auto piece = chessboard.getBoardPiece(x, y);
-                    if(!piece.isEmpty())
-                        return false;
-                }
-            }
-
-            return true;
-        } else if(ys == yd) {
-            auto x = xs;
-            auto y = ys;
-            if(adx) {
-                auto inc_x = dx / adx;
-                for(position_t i = 0; i < adx - 1; ++i) {
-                    x += inc_x;
-                    auto piece = chessboard.getBoardPiece(x, y);
-                    if(!piece.isEmpty())
-                        return false;
-                }
-            }
-
-            return true;
-        }
+        auto attacks = getRookAttacks(getSquare(xs, ys), chessboard.getBoard().getOccupancy());
+        return attacks & getSquareMask(getSquare(xd, yd));
+    }
 
-        return false;
+    static bool isQueenMoveValid(position_t xs, position_t ys, position_t xd, position_t yd, Piece::eColor, const Chess& chessboard)
+    {
+        auto attacks = getQueenAttacks(getSquare(xs, ys), chessboard.getBoard().getOccupancy());
+        return attacks & getSquareMask(getSquare(xd, yd));
     }
 }
-    static std::vector<std::tuple<Piece, position_t, position_t, position_t, position_t>> isPawnMoveValid(Piece piece, position_t xs, position_t ys, position_t xd, position_t yd, const Chess& chessboard)
+    static Move isPawnMoveValid(Piece piece, position_t xs, position_t ys, position_t xd, position_t yd, const Chess& chessboard)
     {
         auto color = piece.getColor();
         const auto pieceMove = chessboard.getPawnDirection(color);
         if(yd == ys + pieceMove) {
             if(xd == xs)
 //                if(chessboard.getBoardPiece(xd, yd).isEmpty())
-                    return { { piece, xs, ys, xd, yd } };
-        } else if(!piece.hasMoved() && yd == ys + (pieceMove * 2)) {
+                    return Move(getSquare(xs, ys), getSquare(xd, yd));
+        } else if(ys == (pieceMove > 0 ? Chess::RANK_1 + 1 : Chess::RANK_8 - 1) && yd == ys + (pieceMove * 2)) {
             if(xd == xs) {
                 if(detail::isRookMoveValid(xs, ys, xd, yd, color, chessboard))
-                    return { { piece, xs, ys, xd, yd } };
+                    return Move(getSquare(xs, ys), getSquare(xd, yd));
             }
         }
 
-        return {};
+        return Move();
     }
 
-    static std::vector<std::tuple<Piece, position_t, position_t, position_t, position_t>> isKnightMoveValid(Piece piece, position_t xs, position_t ys, position_t xd, position_t yd, const Chess&)
+    static Move isKnightMoveValid(Piece, position_t xs, position_t ys, position_t xd, position_t yd, const Chess&)
     {
-        static const std::vector<std::pair<position_t, position_t>> KNIGHT_VALID_MOVES =
-        {
-            { -1, -2 },
-            { 1, - 2 },
-            { -1, 2 },
-            { 1, 2 },
-            { -2, 1 },
-            { -2, -1 },
-            { 2, 1 },
-            { 2, -1 }
-        };
+        if(getKnightAttacks(getSquare(xs, ys)) & getSquareMask(getSquare(xd, yd)))
+            return Move(getSquare(xs, ys), getSquare(xd, yd));
 
-        for(const auto& moves : KNIGHT_VALID_MOVES) {
-            if(xd == xs + moves.first && yd == ys + moves.second)
-                return { { piece, xs, ys, xd, yd } };
-        }
-
-        return {};
+        return Move();
     }
 
-    static std::vector<std::tuple<Piece, position_t, position_t, position_t, position_t>> isBishopMoveValid(Piece piece, position_t xs, position_t ys, position_t xd, position_t yd, const Chess& chessboard)
+    static Move isBishopMoveValid(Piece piece, position_t xs, position_t ys, position_t xd, position_t yd, const Chess& chessboard)
     {
         if(detail::isBishopMoveValid(xs, ys, xd, yd, piece.getColor(), chessboard))
-            return { { piece, xs, ys, xd, yd } };
+            return Move(getSquare(xs, ys), getSquare(xd, yd));
 
-        return {};
+        return Move();
     }
 
-    static std::vector<std::tuple<Piece, position_t, position_t, position_t, position_t>> isRookMoveValid(Piece piece, position_t xs, position_t ys, position_t xd, position_t yd, const Chess& chessboard)
+    static Move isRookMoveValid(Piece piece, position_t xs, position_t ys, position_t xd, position_t yd, const Chess& chessboard)
     {
         if(detail::isRookMoveValid(xs, ys, xd,yd, piece.getColor(), chessboard))
-            return { { piece, xs, ys, xd, yd } };
+            return Move(getSquare(xs, ys), getSquare(xd, yd));
 
-        return {};
+        return Move();
     }
 
-    static std::vector<std::tuple<Piece, position_t, position_t, position_t, position_t>> isQueenMoveValid(Piece piece, position_t xs, position_t ys, position_t xd, position_t yd, const Chess& chessboard)
+    static Move isQueenMoveValid(Piece piece, position_t xs, position_t ys, position_t xd, position_t yd, const Chess& chessboard)
     {
-        auto color = piece.getColor();
-        if(detail::isBishopMoveValid(xs, ys, xd, yd, color, chessboard) ||
-           detail::isRookMoveValid(xs, ys, xd, yd, color, chessboard))
-            return { { piece, xs, ys, xd, yd } };
+        if(detail::isQueenMoveValid(xs, ys, xd, yd, piece.getColor(), chessboard))
+            return Move(getSquare(xs, ys), getSquare(xd, yd));
 
-        return {};
+        return Move();
     }
 
-    static std::vector<std::tuple<Piece, position_t, position_t, position_t, position_t>> isKingSpecialMoveValid(Piece piece, position_t xs, position_t ys, position_t xd, position_t yd, const Chess& chessboard)
+    static Move isKingSpecialMoveValid(Piece piece, position_t xs, position_t ys, position_t xd, position_t yd, const Chess& chessboard)
     {
         // castling:
         // - The king cannot be in check
         // - nor can the king pass through any square that is under attack by an enemy piece,
         // - or move to a square that would result in check.
-        if(!piece.hasMoved()) {
-            auto dx = xd - xs;
-            auto adx = std::abs(dx);
-            if(ys == yd && adx == 2) {
-                if(!isCheck(Chess::PieceInformation(piece, xs, ys), xs, ys, chessboard).size()) {
+        auto dx = xd - xs;
+        const position_t rookX = dx < 0 ? 0 : static_cast<position_t>(BOARD_WIDTH - 1);
+        if(getDistance(getSquare(xs, ys), getSquare(xd, yd)) == 2 && chessboard.canCastle(piece.getColor(), rookX)) {
+            if(ys == yd) {
+                const auto oppositeColor = getOppositeColor(piece.getColor());
+                if(!chessboard.isSquareAttacked(getSquare(xs, ys), oppositeColor)) {
                     auto xf = xs;
-                    auto inc_x = dx / adx;
+                    auto inc_x = dx / 2;
                     const auto IBOARD_WIDTH = static_cast<position_t>(BOARD_WIDTH);
                     while(xf >= 0 && xf < IBOARD_WIDTH) {
                         xf += inc_x;
                         auto otherPiece = chessboard.getBoardPiece(xf, ys);
                         if(!otherPiece.isEmpty()) {
-                            if(otherPiece.getType() == Piece::Type::ROOK && piece.getColor() == otherPiece.getColor() && !otherPiece.hasMoved()) {
+                            if(xf == rookX) {
                                 auto xm = xs + inc_x;
-                                if(!isCheck(Chess::PieceInformation(piece, xs, ys), xm, ys, chessboard).size()) {
-                                    return
-                                    {
-                                        { piece, xs, ys, xd, yd },
-                                        { otherPiece, xf, ys, xd + (inc_x * - 1), yd }
-                                    };
+                                if(!chessboard.isSquareAttacked(getSquare(xm, ys), oppositeColor)) {
+                                    return Move(getSquare(xs, ys), getSquare(xd, yd), Move::eFlag::Castling);
                                 }
                             } else
-                                return {};
+                                return Move();
                         }
                     }
                 }
             }
         }
 
-        return {};
+        return Move();
     }
 
-    static std::vector<std::tuple<Piece, position_t, position_t, position_t, position_t>> isKingMoveValid(Piece piece, position_t xs, position_t ys, position_t xd, position_t yd, const Chess& chessboard)
+    static Move isKingMoveValid(Piece piece, position_t xs, position_t ys, position_t xd, position_t yd, const Chess& chessboard)
     {
-        auto dx = xd - xs;
-        auto dy = yd - ys;
-        auto adx = std::abs(dx);
-        auto ady = std::abs(dy);
-        if(adx <= 1 && ady <= 1) {
-            auto oppositeColor = getOppositeColor(piece.getColor());
-            const auto& otherKing = chessboard.getKing(oppositeColor);
-            const auto& otherKingPosition = otherKing.getPosition();
-
-            auto kdx = otherKingPosition.x - xd;
-            auto kdy = otherKingPosition.y - yd;
-            if(std::abs(kdx) > 1 || std::abs(kdy) > 1)
-                return { { piece, xs, ys, xd, yd } };
+        auto toSquare = getSquare(xd, yd);
+        if(getKingAttacks(getSquare(xs, ys)) & getSquareMask(toSquare)) {
+            // the kings can never stand next to each other
+            if(getDistance(chessboard.getKingSquare(getOppositeColor(piece.getColor())), toSquare) > 1)
+                return Move(getSquare(xs, ys), toSquare);
         }
 
         return isKingSpecialMoveValid(piece, xs, ys, xd, yd, chessboard);
@@ -219,27 +143,27 @@ namespace detail
         return xs == xd && ys == yd;
     }
 
-    std::vector<std::tuple<Piece, position_t, position_t, position_t, position_t>> isMoveValid(Piece piece, position_t xs, position_t ys, position_t xd, position_t yd, const Chess& chessboard)
+    Move isMoveValid(Piece piece, position_t xs, position_t ys, position_t xd, position_t yd, const Chess& chessboard)
     {
-        using function_ptr_type = std::vector<std::tuple<Piece, position_t, position_t, position_t, position_t>>(*)(Piece piece, position_t xs, position_t ys, position_t xd, position_t yd, const Chess& chessboard);
+        using function_ptr_type = Move(*)(Piece piece, position_t xs, position_t ys, position_t xd, position_t yd, const Chess& chessboard);
 
-        static const std::unordered_map<Piece::Type, function_ptr_type> TYPE_TO_MOVE =
+        // indexed by the type index of the piece
+        static constexpr function_ptr_type TYPE_TO_MOVE[Piece::NUMBER_OF_TYPE] =
         {
-            { Piece::Type::PAWN, &isPawnMoveValid },
-            { Piece::Type::KNIGHT, &isKnightMoveValid },
-            { Piece::Type::BISHOP, &isBishopMoveValid },
-            { Piece::Type::ROOK, &isRookMoveValid },
-            { Piece::Type::QUEEN, &isQueenMoveValid },
-            { Piece::Type::KING, &isKingMoveValid }
+            &isPawnMoveValid,
+            &isKnightMoveValid,
+            &isBishopMoveValid,
+            &isRookMoveValid,
+            &isQueenMoveValid,
+            &isKingMoveValid
         };
 
 //        if(!piece.isEmpty()) {
         assert(!piece.isEmpty());
         if(isSelfMove(xs, ys, xd, yd))
-            return {};
+            return Move();
 
-        assert(TYPE_TO_MOVE.find(piece.getType()) != TYPE_TO_MOVE.end()); // if this spits an error, we made a mistake in making the piece
-        return (*TYPE_TO_MOVE.at(piece.getType()))(piece, xs, ys, xd, yd, chessboard);
+        return (*TYPE_TO_MOVE[piece.getTypeIndex()])(piece, xs, ys, xd, yd, chessboard);
 //        }
 
 //        return {};
@@ -17,7 +17,7 @@
 #pragma once
 
 // headers
-#include <vector>
+#include "../move/move.h"
 #include "../types.h"
 #include "piece.h"
 
@@ -25,5 +25,5 @@ namespace cchess
 {
     class Chess;
     bool isSelfMove(position_t xs, position_t ys, position_t xd, position_t yd);
-    std::vector<std::tuple<Piece, position_t, position_t, position_t, position_t>> isMoveValid(Piece piece, position_t xs, position_t ys, position_t xd, position_t yd, const Chess& chessboard);
+    Move isMoveValid(Piece piece, position_t xs, position_t ys, position_t xd, position_t yd, const Chess& chessboard);
 }
@@ -18,61 +18,44 @@
 
 // headers
 #include <vector>
-#include "../3rdparty/data/base_data.h"
+#include "../move/move.h"
 #include "../piece/piece.h"
 #include "../types.h"
+#include "boardStateManager.h"
 
 namespace cchess
 {
-    class Chess;
     class BoardHistoryManager
     {
-        static constexpr char DESC_MOVE = 'M';
-        static constexpr char DESC_CAPTURE = 'C';
-        static constexpr char DESC_PROMOTION = 'P';
+    public:
+        static constexpr std::size_t INITIAL_CAPACITY = 1024;
 
-        class MoveDescription
+        // everything needed to take a move back
+        struct UndoRecord
         {
-        public:
-            // move constructor
-            MoveDescription(bool hasMoved, position_t xs, position_t ys, position_t xd, position_t yd);
-
-            // capture constructor
-            MoveDescription(Piece::eColor color);
-
-            // promotion constructor
-            MoveDescription(Piece pieceToPromoteFrom, position_t x, position_t y);
-
-            // get description
-            char getDescription() const;
-
-        private:
-            friend class BoardHistoryManager;
-
-            mar::unique_base_data m_data;
+            Move                            move;
+            Piece                           movedPiece;         // the moved piece, as it was before the move
+            Piece                           capturedPiece;
+            std::int8_t                     enPassantSquare;    // the en passant pawn of the color that moved, before the move
+            BoardStateManager::state_type   previousState;
+            unsigned int                    halfmoveClock;
+            unsigned char                   castlingRights;
+            bool                            isStateRecorded;    // the move is on the repetition states
         };
 
-    public:
         BoardHistoryManager();
 
-        void addMoveToHistory(const std::vector<std::tuple<Piece, position_t, position_t, position_t, position_t>>& moves);
-        void addCaptureToHistory(Piece::eColor color, bool hasMoved, position_t xs, position_t ys, position_t xd, position_t yd);
-        void addPromotionToHistory(Piece pieceToPromoteFrom, position_t x, position_t y);
-        void addLastEnPassant(Piece::eColor color, position_t x, position_t y);
+        void addRecord(const UndoRecord& record) { m_records.push_back(record); }
+        UndoRecord& getLastRecord() { return m_records.back(); }
+        const UndoRecord& getLastRecord() const { return m_records.back(); }
+        void removeLastRecord() { m_records.pop_back(); }
 
         void resetHistory();
 
-        bool isThereHistoryToUndo() const { return m_moveHistory.size(); }
-        bool undoLastMove(Chess& chessboard);
+        bool isThereHistoryToUndo() const { return m_records.size(); }
+        std::size_t getNumberOfRecords() const { return m_records.size(); }
 
     private:
-        std::vector<MoveDescription> convertMovesToMoveDescriptions(const std::vector<std::tuple<Piece, position_t, position_t, position_t, position_t>>& moves);
-
-        void undoMove(Chess& chessboard, const MoveDescription& md);
-        void undoCapture(Chess& chessboard, const MoveDescription& md);
-        void undoPromotion(Chess& chessboard, const MoveDescription& md);
-
-        std::vector<std::vector<MoveDescription>>                                   m_moveHistory;
-        std::vector<std::pair<Piece::eColor, std::pair<position_t, position_t>>>    m_enPassant;
+        std::vector<UndoRecord> m_records;
     };
 }
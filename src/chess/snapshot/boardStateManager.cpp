@@ -15,107 +15,162 @@
  *
  **********/
 // headers
-#include <unordered_map>
+#include <assert.h>
 #include "../chess.h"
 #include "boardStateManager.h"
 
 namespace cchess
 {
-    BoardStateManager::BoardStateManager(const Chess& chessboard)
+    BoardStateManager::BoardStateManager() :
+        m_currentBoardState(0),
+        m_bottomColor(Piece::eColor::white)
     {
-        resetStates(chessboard);
+        m_boardStates.push_back({ m_currentBoardState, 0, false });
     }
 
     void BoardStateManager::resetStates(const Chess& chessboard)
     {
-        m_currentBoardState = 0;
-        m_threefoldRepetition = false;
+        m_bottomColor = chessboard.getBottomColor();
+        m_currentBoardState = computeState(chessboard);
 
-        // initialize the state of the board
-        for(auto x = 0; x < BOARD_WIDTH; ++x) {
-            for(auto y = 0; y < BOARD_HEIGHT; ++y) {
-                auto piece = chessboard.getBoardPiece(x, y);
+        m_boardStates.clear();
+        m_boardStates.push_back({ m_currentBoardState, chessboard.getHalfmoveClock(), false });
+    }
 
-                if(!piece.isEmpty())
-                    m_currentBoardState = m_zobristTable.toggleState(m_currentBoardState, x, y, getPieceState(piece));
-            }
+    void BoardStateManager::togglePositionState(const Chess& chessboard)
+    {
+        m_currentBoardState = togglePositionState(m_currentBoardState, chessboard);
+    }
+
+    void BoardStateManager::updateState(const Board& board, Move move, Piece movedPiece, Piece capturedPiece)
+    {
+        // the board has already been updated, so the moved piece, promoted or not, is on the destination
+        toggleState(move.getFrom(), movedPiece);
+        toggleState(move.getTo(), board.getPiece(move.getTo()));
+
+        if(!capturedPiece.isEmpty())
+            toggleState(getCapturedSquare(move), capturedPiece);
+
+        // a castling moves the rook too, but is still a single state
+        if(move.getFlag() == Move::eFlag::Castling) {
+            auto rookMove = getCastlingRookMove(move);
+            auto rook = board.getPiece(rookMove.getTo());
+            toggleState(rookMove.getFrom(), rook);
+            toggleState(rookMove.getTo(), rook);
         }
 
-        m_boardStates.clear();
-        m_boardStatesRepetitions.clear();
+        m_currentBoardState = ZOBRIST_TABLE.toggleSideState(m_currentBoardState);
+    }
+
+    void BoardStateManager::updateStateOnPromotion(Piece pieceToPromoteFrom, Piece pieceToPromoteTo, position_t x, position_t y)
+    {
+        // the promotion is part of the last move, so it replaces the last state
+        auto halfmoveClock = m_boardStates.back().halfmoveClock;
+        popCurrentState();
+        toggleState(getSquare(x, y), pieceToPromoteFrom);
+        toggleState(getSquare(x, y), pieceToPromoteTo);
+        recordState(halfmoveClock);
     }
 
-    void BoardStateManager::updateStateOnMove(Piece piece, position_t xs, position_t ys, position_t xd, position_t yd)
+    bool BoardStateManager::undoLastState()
     {
-        m_currentBoardState = m_zobristTable.toggleState(m_currentBoardState, xs, ys, getPieceState(piece));
-        m_currentBoardState = m_zobristTable.toggleState(m_currentBoardState, xd, yd, getPieceState(piece));
+        if(isThereStateToUndo()) {
+            popCurrentState();
+            m_currentBoardState = m_boardStates.back().state;
+            return true;
+        }
 
-        m_boardStates.push_back(m_currentBoardState);
-        ++m_boardStatesRepetitions[m_currentBoardState];
+        return false;
+    }
 
-        if(m_boardStatesRepetitions[m_currentBoardState] >= 3)
-            m_threefoldRepetition = true;
+    bool BoardStateManager::isStateValid(const Chess& chessboard) const
+    {
+        return chessboard.getBottomColor() == m_bottomColor && computeState(chessboard) == m_currentBoardState;
     }
 
-    void BoardStateManager::updateStateOnCapture(Piece piece, Piece capturedPiece, position_t xs, position_t ys, position_t xd, position_t yd, position_t xc, position_t yc)
+    void BoardStateManager::recordState(unsigned int halfmoveClock)
     {
-        m_currentBoardState = m_zobristTable.toggleState(m_currentBoardState, xc, yc, getPieceState(capturedPiece));
-        updateStateOnMove(piece, xs, ys, xd, yd);
+        // a position can only repeat with the same side to move, and not
+        // before the last capture or pawn move, since those can't be reversed
+        unsigned int repetitions = 1;
+        const auto size = m_boardStates.size();
+        for(std::size_t plies = 2; plies <= halfmoveClock && plies <= size; plies += 2) {
+            if(m_boardStates[size - plies].state == m_currentBoardState)
+                ++repetitions;
+        }
+
+        m_boardStates.push_back({ m_currentBoardState, halfmoveClock, repetitions >= 3 });
     }
 
-    bool BoardStateManager::undoLastState()
+    BoardStateManager::state_type BoardStateManager::computeState(const Chess& chessboard) const
+    {
+        state_type state = 0;
+
+        for(position_t square = 0; square < NUMBER_OF_SQUARES; ++square) {
+            auto piece = chessboard.getBoard().getPiece(square);
+
+            if(!piece.isEmpty())
+                state = toggleState(state, square, piece);
+        }
+
+        if(chessboard.getCurrentColorsTurn() == Piece::eColor::black)
+            state = ZOBRIST_TABLE.toggleSideState(state);
+
+        return togglePositionState(state, chessboard);
+    }
+
+    BoardStateManager::state_type BoardStateManager::togglePositionState(state_type state, const Chess& chessboard) const
     {
-        if(m_boardStates.size()) {
-            auto lastState = m_boardStates.back();
-            --m_boardStatesRepetitions.at(lastState);
-            m_boardStates.pop_back();
-
-            // search the container if there are still threefold repetitions
-            m_threefoldRepetition = false;
-            for(const auto& p : m_boardStatesRepetitions) {
-                if(p.second >= 3) {
-                    m_threefoldRepetition = true;
+        // the castling rights are already K Q k q, whatever the side of the board the colors are on
+        const auto castlingRights = chessboard.getCastlingRights();
+        for(std::size_t i = 0; i < zobrist_table_type::NUMBER_OF_CASTLING_RIGHTS; ++i) {
+            if(castlingRights & (1 << i))
+                state = ZOBRIST_TABLE.toggleCastlingState(state, i);
+        }
+
+        // the en passant file only counts when a pawn of the side to move can capture it
+        const auto color = chessboard.getCurrentColorsTurn();
+        const auto& enPassantPosition = chessboard.getEnPassantPosition(getOppositeColor(color));
+        if(enPassantPosition.x >= 0) {
+            for(auto x : { enPassantPosition.x - 1, enPassantPosition.x + 1 }) {
+                auto pawn = chessboard.getBoardPiece(x, enPassantPosition.y);
+                if(pawn.getType() == Piece::Type::PAWN && pawn.getColor() == color) {
+                    state = ZOBRIST_TABLE.toggleEnPassantState(state, getSquareX(getCanonicalSquare(getSquare(enPassantPosition.x, enPassantPosition.y))));
                     break;
                 }
             }
-            return true;
         }
 
-        return false;
+        return state;
+    }
+
+    void BoardStateManager::toggleState(position_t square, Piece piece)
+    {
+        m_currentBoardState = toggleState(m_currentBoardState, square, piece);
+    }
+
+    BoardStateManager::state_type BoardStateManager::toggleState(state_type state, position_t square, Piece piece) const
+    {
+        auto canonicalSquare = getCanonicalSquare(square);
+        return ZOBRIST_TABLE.toggleState(state, getSquareX(canonicalSquare), getSquareY(canonicalSquare), getPieceState(piece));
+    }
+
+    position_t BoardStateManager::getCanonicalSquare(position_t square) const
+    {
+        // the keys are taken from the squares of a board with white on the bottom, so the
+        // same position has the same key on every board. turning the board around reverses the squares
+        return m_bottomColor == Piece::eColor::white ? square : NUMBER_OF_SQUARES - 1 - square;
+    }
+
+    void BoardStateManager::popCurrentState()
+    {
+        assert(isThereStateToUndo() && m_boardStates.back().state == m_currentBoardState);
+        m_boardStates.pop_back();
     }
 
-    std::size_t BoardStateManager::getPieceState(Piece piece)
+    std::size_t BoardStateManager::getPieceState(Piece piece) const
     {
-        static const std::unordered_map<Piece::Type, std::size_t> PIECE_TO_INDEX =
-        {
-            { Piece::Type::PAWN, 0 },
-            { Piece::Type::KNIGHT, 2 },
-            { Piece::Type::BISHOP, 6 },
-            { Piece::Type::ROOK, 10 },
-            { Piece::Type::QUEEN, 14 },
-            { Piece::Type::KING, 16 },
-        };
-
-        // how to visualize colorIndex, idIndex, pieceIndex:
-        // ex: knight
-        // wk0 wk1 bk0 bk1
-        //
-        // piece + color + id = table index
-        // 2 + (0) + 0 = 2
-        // 2 + (0) + 1 = 3
-        // 2 + (2) + 0 = 4
-        // 2 + (2) + 1 = 5
-
-        auto pieceType = piece.getType();
-        bool isNotIdedTypes = (pieceType == Piece::Type::PAWN ||
-                               pieceType == Piece::Type::QUEEN ||
-                               pieceType == Piece::Type::KING);
-
-        auto colorIndex = piece.getColor() == Piece::eColor::white ? 0 : 1;
-        colorIndex = isNotIdedTypes ? colorIndex : colorIndex * 2;
-        auto idIndex = isNotIdedTypes ? 0 : piece.getId();
-        auto pieceIndex = PIECE_TO_INDEX.at(pieceType);
-
-        return pieceIndex + colorIndex + idIndex;
+        // a state for every type and color: wp bp wn bn ...
+        return piece.getTypeIndex() * Piece::NUMBER_OF_COLOR + getColorIndex(piece.getColor());
     }
 }
@@ -17,8 +17,9 @@
 #pragma once
 
 // headers
-#include <unordered_map>
 #include <vector>
+#include "../board/board.h"
+#include "../move/move.h"
 #include "../piece/piece.h"
 #include "../define.h"
 #include "../types.h"
@@ -28,38 +29,60 @@ namespace cchess
 {
     class Chess;
 
-    /// TODO:
-    /// Add state for en passant pawns
-    /// Add state for kings that can castle
+    // the zobrist key of a position: the pieces, the side to move,
+    // the castling rights and the file of a pawn that can be captured en passant
     class BoardStateManager
     {
-        static constexpr std::size_t NUMBER_OF_PIECE_STATES = 18;
+        static constexpr std::size_t NUMBER_OF_PIECE_STATES = Piece::NUMBER_OF_COLOR * Piece::NUMBER_OF_TYPE;
         using zobrist_table_type = ZobristKeyTable<BOARD_WIDTH, BOARD_HEIGHT, NUMBER_OF_PIECE_STATES>;
-        using state_type = zobrist_table_type::state_type;
 
     public:
-        BoardStateManager(const Chess& chessboard);
+        using state_type = zobrist_table_type::state_type;
+
+        BoardStateManager();
 
         void resetStates(const Chess& chessboard);
 
-        void updateStateOnMove(Piece piece, position_t xs, position_t ys, position_t xd, position_t yd);
-        void updateStateOnCapture(Piece piece, Piece capturedPiece, position_t xs, position_t ys, position_t xd, position_t yd, position_t xc, position_t yc);
+        // the castling rights and the en passant file are taken out before a move,
+        // and put back once the move is done
+        void togglePositionState(const Chess& chessboard);
+        void updateState(const Board& board, Move move, Piece movedPiece, Piece capturedPiece);
+        void updateStateOnPromotion(Piece pieceToPromoteFrom, Piece pieceToPromoteTo, position_t x, position_t y);
+        void setCurrentState(state_type state) { m_currentBoardState = state; }
+        void recordState(unsigned int halfmoveClock);
 
-        bool isThereStateToUndo() const { return m_boardStates.size(); }
+        bool isThereStateToUndo() const { return m_boardStates.size() > 1; }
         bool undoLastState();
 
-        bool isThereThreefoldRepetition() const { return m_threefoldRepetition; }
+        bool isThereThreefoldRepetition() const { return m_boardStates.back().isThreefoldRepetition; }
         state_type getCurrentState() const { return m_currentBoardState; }
 
+        // recomputes the key from scratch, for debug checks
+        bool isStateValid(const Chess& chessboard) const;
+
     private:
-        std::size_t getPieceState(Piece piece);
+        // shared by every board, and generated at compile time
+        static constexpr zobrist_table_type ZOBRIST_TABLE = zobrist_table_type();
 
-        zobrist_table_type                              m_zobristTable;
-        state_type                                      m_currentBoardState;
+        struct StateRecord
+        {
+            state_type      state;
+            unsigned int    halfmoveClock;          // plies since the last capture or pawn move
+            bool            isThreefoldRepetition;
+        };
+
+        state_type computeState(const Chess& chessboard) const;
+        state_type togglePositionState(state_type state, const Chess& chessboard) const;
+        std::size_t getPieceState(Piece piece) const;
+        void toggleState(position_t square, Piece piece);
+        state_type toggleState(state_type state, position_t square, Piece piece) const;
+        position_t getCanonicalSquare(position_t square) const;
+        void popCurrentState();
 
-        std::vector<state_type>                         m_boardStates;
-        std::unordered_map<state_type, unsigned int>    m_boardStatesRepetitions;
+        state_type                                      m_currentBoardState;
+        Piece::eColor                                   m_bottomColor;
 
-        bool                                            m_threefoldRepetition;
+        // the first state is the starting position
+        std::vector<StateRecord>                        m_boardStates;
     };
 }
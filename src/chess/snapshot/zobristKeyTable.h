@@ -17,8 +17,9 @@
 #pragma once
 
 // headers
-#include "../3rdparty/container/fixed_sized_array.h"
-#include <random>
+#include <assert.h>
+#include <array>
+#include <cinttypes>
 
 namespace cchess
 {
@@ -27,27 +28,33 @@ namespace cchess
              std::size_t NumberOfStates>
     class ZobristKeyTable
     {
-        static std::mt19937 randomizer;
+        // the table is generated at compile time from a fixed seed, so the
+        // keys are the same for every board, process and run
+        static constexpr std::uint64_t SEED = 01234567;
 
     public:
         using state_type = unsigned long long int;
 
-        ZobristKeyTable();
+        // king and queen side, for both colors
+        static constexpr std::size_t NUMBER_OF_CASTLING_RIGHTS = 4;
+
+        constexpr ZobristKeyTable();
 
         state_type toggleState(state_type state, std::size_t x, std::size_t y, std::size_t z) const;
+        state_type toggleSideState(state_type state) const { return state ^ m_sideKey; }
+        state_type toggleCastlingState(state_type state, std::size_t castlingRight) const;
+        state_type toggleEnPassantState(state_type state, std::size_t x) const;
 
     private:
-        using table_type = mar::container::fixed_sized_array<std::array<state_type, NumberOfStates>, Width * Height>;
+        using table_type = std::array<std::array<state_type, NumberOfStates>, Width * Height>;
 
-        state_type getRandomInteger() const;
+        static constexpr state_type getRandomInteger(std::uint64_t& seed);
 
-        table_type m_table;
+        table_type                                              m_table;
+        state_type                                              m_sideKey;
+        std::array<state_type, NUMBER_OF_CASTLING_RIGHTS>       m_castlingKeys;
+        std::array<state_type, Width>                           m_enPassantKeys;
     };
-
-    template<std::size_t Width,
-             std::size_t Height,
-             std::size_t NumberOfStates>
-    std::mt19937 ZobristKeyTable<Width, Height, NumberOfStates>::randomizer(01234567);
 }
 
 // definitions
@@ -19,14 +19,26 @@
 namespace cchess
 {
     template<std::size_t Width, std::size_t Height, std::size_t NumberOfStates>
-    ZobristKeyTable<Width, Height, NumberOfStates>::ZobristKeyTable()
+    constexpr ZobristKeyTable<Width, Height, NumberOfStates>::ZobristKeyTable() :
+        m_table(),
+        m_sideKey(0),
+        m_castlingKeys(),
+        m_enPassantKeys()
     {
         // initialize the zobrist table
+        std::uint64_t randomizer = SEED;
         for(std::size_t i = 0, i_size = Width * Height; i < i_size; ++i) {
             for(std::size_t j = 0; j < NumberOfStates; ++j) {
-                m_table[i][j] = getRandomInteger();
+                m_table[i][j] = getRandomInteger(randomizer);
             }
         }
+
+        // the keys of the position come after the keys of the pieces
+        m_sideKey = getRandomInteger(randomizer);
+        for(auto& key : m_castlingKeys)
+            key = getRandomInteger(randomizer);
+        for(auto& key : m_enPassantKeys)
+            key = getRandomInteger(randomizer);
     }
 
     template<std::size_t Width, std::size_t Height, std::size_t NumberOfStates>
@@ -40,9 +52,28 @@ namespace cchess
     }
 
     template<std::size_t Width, std::size_t Height, std::size_t NumberOfStates>
-    typename ZobristKeyTable<Width, Height, NumberOfStates>::state_type ZobristKeyTable<Width, Height, NumberOfStates>::getRandomInteger() const
+    typename ZobristKeyTable<Width, Height, NumberOfStates>::state_type ZobristKeyTable<Width, Height, NumberOfStates>::toggleCastlingState(state_type state, std::size_t castlingRight) const
+    {
+        assert(castlingRight < NUMBER_OF_CASTLING_RIGHTS);
+        return state ^ m_castlingKeys[castlingRight];
+    }
+
+    template<std::size_t Width, std::size_t Height, std::size_t NumberOfStates>
+    typename ZobristKeyTable<Width, Height, NumberOfStates>::state_type ZobristKeyTable<Width, Height, NumberOfStates>::toggleEnPassantState(state_type state, std::size_t x) const
     {
-        std::uniform_int_distribution<state_type> dist(0, std::numeric_limits<state_type>::max());
-        return dist(randomizer);
+        assert(x < Width);
+        return state ^ m_enPassantKeys[x];
+    }
+
+    template<std::size_t Width, std::size_t Height, std::size_t NumberOfStates>
+    constexpr typename ZobristKeyTable<Width, Height, NumberOfStates>::state_type ZobristKeyTable<Width, Height, NumberOfStates>::getRandomInteger(std::uint64_t& seed)
+    {
+        // splitmix64
+        seed += 0x9E3779B97F4A7C15ull;
+        auto z = seed;
+        z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+        z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+
+        return z ^ (z >> 31);
     }
 }
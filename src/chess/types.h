@@ -22,4 +22,5 @@
 namespace cchess
 {
     using position_t = std::int16_t;
+    using bitboard_t = std::uint64_t;
 }
@@ -0,0 +1,226 @@
+/**********
+ *
+ *     This program is free software: you can redistribute it and/or modify
+ *     it under the terms of the GNU General Public License as published by
+ *     the Free Software Foundation, either version 3 of the License, or
+ *     (at your option) any later version.
+ * 
+ *     This program is distributed in the hope that it will be useful,
+ *     but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *     MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *     GNU General Public License for more details.
+ * 
+ *     You should have received a copy of the GNU General Public License
+ *     along with this program.  If not, see <https://www.gnu.org/licenses/>. 
+ *
+ **********/
+// headers
+#include <assert.h>
+#include <atomic>
+#include <memory>
+#include <thread>
+#include <vector>
+#include "../chess/3rdparty/high_resolution_clock.h"
+#include "../chess/move/moveList.h"
+#include "perft.h"
+
+namespace cchess_perft
+{
+namespace
+{
+    // a root move and one of its replies, the unit of work of the threads
+    struct PerftWork
+    {
+        PerftWork(std::size_t rootIndex_, cchess::Move rootMove_, cchess::Move secondMove_) :
+            rootIndex(rootIndex_),
+            rootMove(rootMove_),
+            secondMove(secondMove_),
+            nodes(0)
+        {
+        }
+
+        std::size_t     rootIndex;
+        cchess::Move    rootMove;
+        cchess::Move    secondMove;
+        std::uint64_t   nodes;
+    };
+
+    bool setupPosition(cchess::Chess& chessboard, const std::string& position)
+    {
+        chessboard.resetBoard(cchess::Piece::eColor::white);
+        if(position == "startpos")
+            return true;
+
+        return chessboard.setFromFEN(position);
+    }
+
+    unsigned int getNumberOfThreads(unsigned int threads)
+    {
+        if(threads == 0)
+            threads = std::thread::hardware_concurrency();
+
+        return threads > 0 ? threads : 1;
+    }
+
+    std::vector<PerftWork> splitWork(cchess::Chess& chessboard, const cchess::MoveList& rootMoves)
+    {
+        std::vector<PerftWork> ret;
+
+        for(std::size_t i = 0, i_size = rootMoves.size(); i < i_size; ++i) {
+            auto rootMove = rootMoves[i];
+            chessboard.doMove(rootMove);
+
+            cchess::MoveList secondMoves;
+            chessboard.generateLegalMoves(chessboard.getCurrentColorsTurn(), secondMoves);
+            for(auto secondMove : secondMoves)
+                ret.emplace_back(i, rootMove, secondMove);
+
+            chessboard.undoMove();
+        }
+
+        return ret;
+    }
+
+    // counts the nodes under every root move, splitting the root and second ply moves
+    // across the threads. every thread plays on its own board
+    std::vector<std::uint64_t> runParallelPerft(cchess::Chess& chessboard, const cchess::MoveList& rootMoves, unsigned int depth, unsigned int threads, PerftHashTable* hashTable)
+    {
+        assert(depth >= 2);
+
+        auto work = splitWork(chessboard, rootMoves);
+        threads = std::min<unsigned int>(threads, static_cast<unsigned int>(work.size()));
+
+        const auto& rootPosition = chessboard.getPositionState();
+        std::atomic<std::size_t> nextWork(0);
+        std::vector<std::thread> workers;
+        for(unsigned int i = 0; i < threads; ++i) {
+            workers.emplace_back([&work, &nextWork, &rootPosition, depth, hashTable]() {
+                // every thread plays on its own copy of the root position
+                cchess::Chess workerChessboard;
+                workerChessboard.setPositionState(rootPosition);
+
+                for(auto index = nextWork++; index < work.size(); index = nextWork++) {
+                    auto& w = work[index];
+                    workerChessboard.doMove(w.rootMove);
+                    workerChessboard.doMove(w.secondMove);
+                    w.nodes = perft(workerChessboard, depth - 2, hashTable);
+                    workerChessboard.undoMove();
+                    workerChessboard.undoMove();
+                }
+            });
+        }
+
+        for(auto& worker : workers)
+            worker.join();
+
+        // merge the counts of the replies into their root move
+        std::vector<std::uint64_t> ret(rootMoves.size(), 0);
+        for(const auto& w : work)
+            ret[w.rootIndex] += w.nodes;
+
+        return ret;
+    }
+
+    std::vector<std::uint64_t> runSerialPerft(cchess::Chess& chessboard, const cchess::MoveList& rootMoves, unsigned int depth, PerftHashTable* hashTable)
+    {
+        std::vector<std::uint64_t> ret;
+        ret.reserve(rootMoves.size());
+
+        for(auto move : rootMoves) {
+            chessboard.doMove(move);
+            ret.push_back(perft(chessboard, depth - 1, hashTable));
+            chessboard.undoMove();
+        }
+
+        return ret;
+    }
+}
+    std::uint64_t perft(cchess::Chess& chessboard, unsigned int depth, PerftHashTable* hashTable)
+    {
+        if(depth == 0)
+            return 1;
+
+        cchess::MoveList moves;
+        chessboard.generateLegalMoves(chessboard.getCurrentColorsTurn(), moves);
+
+        // the moves of the last ply are leaves, so they don't need to be played
+        if(depth == 1)
+            return moves.size();
+
+        std::uint64_t ret = 0;
+        PerftHashTable::key_type key = 0;
+        if(hashTable) {
+            key = chessboard.getZobristKey();
+            if(hashTable->probe(key, depth, ret))
+                return ret;
+        }
+
+        for(auto move : moves) {
+            chessboard.doMove(move);
+            ret += perft(chessboard, depth - 1, hashTable);
+            chessboard.undoMove();
+        }
+
+        if(hashTable)
+            hashTable->store(key, depth, ret);
+
+        return ret;
+    }
+
+    bool runPerft(const std::string& position, const PerftOptions& options, std::ostream& out)
+    {
+        cchess::Chess chessboard;
+        if(!setupPosition(chessboard, position)) {
+            out << "Unsupported position: " << position << std::endl;
+            return false;
+        }
+
+#ifndef NDEBUG
+        // the keys go through the hash table, so they can't depend on the side the board is laid out from
+        cchess::Chess flippedChessboard;
+        flippedChessboard.resetBoard(cchess::getOppositeColor(chessboard.getBottomColor()));
+        assert(flippedChessboard.setFromFEN(chessboard.toFEN()) && flippedChessboard.getZobristKey() == chessboard.getZobristKey());
+#endif
+
+        mar::high_resolution_clock clock;
+        clock.start();
+
+        std::unique_ptr<PerftHashTable> hashTable;
+        if(options.hashSizeInMB > 0)
+            hashTable.reset(new PerftHashTable(options.hashSizeInMB, options.isHashLockless));
+
+        std::uint64_t nodes = 0;
+        auto depth = options.depth;
+        auto threads = getNumberOfThreads(options.threads);
+        if(depth == 0) {
+            nodes = 1;
+        } else if(!options.divide && (threads == 1 || depth < 3)) {
+            nodes = perft(chessboard, depth, hashTable.get());
+        } else {
+            cchess::MoveList rootMoves;
+            chessboard.generateLegalMoves(chessboard.getCurrentColorsTurn(), rootMoves);
+
+            // with less than 3 plies, there is not enough work to split
+            auto rootNodes = threads > 1 && depth >= 3 ?
+                             runParallelPerft(chessboard, rootMoves, depth, threads, hashTable.get()) :
+                             runSerialPerft(chessboard, rootMoves, depth, hashTable.get());
+
+            for(std::size_t i = 0, i_size = rootMoves.size(); i < i_size; ++i) {
+                if(options.divide)
+                    out << cchess::getMoveString(rootMoves[i]) << ": " << rootNodes[i] << "\n";
+                nodes += rootNodes[i];
+            }
+
+            if(options.divide)
+                out << "\n";
+        }
+
+        auto elapsed = clock.get_elapsed();
+        auto seconds = elapsed.as_seconds();
+        out << "Nodes searched: " << nodes << "\n";
+        out << "Time: " << elapsed.as_milliseconds() << " ms\n";
+        out << "Nodes/second: " << (seconds > 0.0 ? static_cast<std::uint64_t>(nodes / seconds) : nodes) << std::endl;
+
+        return true;
+    }
+}
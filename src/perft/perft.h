@@ -0,0 +1,47 @@
+/**********
+ *
+ *     This program is free software: you can redistribute it and/or modify
+ *     it under the terms of the GNU General Public License as published by
+ *     the Free Software Foundation, either version 3 of the License, or
+ *     (at your option) any later version.
+ * 
+ *     This program is distributed in the hope that it will be useful,
+ *     but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *     MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *     GNU General Public License for more details.
+ * 
+ *     You should have received a copy of the GNU General Public License
+ *     along with this program.  If not, see <https://www.gnu.org/licenses/>. 
+ *
+ **********/
+#pragma once
+
+// headers
+#include <cinttypes>
+#include <ostream>
+#include <string>
+#include "../chess/chess.h"
+#include "perftHashTable.h"
+
+namespace cchess_perft
+{
+    struct PerftOptions
+    {
+        PerftOptions() : depth(0), divide(false), threads(1), hashSizeInMB(0), isHashLockless(false) {}
+
+        unsigned int    depth;
+        bool            divide;         // print the nodes under every root move
+        unsigned int    threads;        // 0 uses every core
+        std::size_t     hashSizeInMB;   // 0 disables the hash table
+        bool            isHashLockless; // share the hash table between threads without locks
+    };
+
+    // counts the leaf nodes of the move tree of the given depth,
+    // the subtrees already in the hash table are not counted again
+    std::uint64_t perft(cchess::Chess& chessboard, unsigned int depth, PerftHashTable* hashTable = nullptr);
+
+    // sets up the position ("startpos" or a FEN), counts the leaf nodes and prints them,
+    // with the time it took and the nodes per second.
+    // returns false if the position cannot be set up
+    bool runPerft(const std::string& position, const PerftOptions& options, std::ostream& out);
+}
@@ -0,0 +1,103 @@
+/**********
+ *
+ *     This program is free software: you can redistribute it and/or modify
+ *     it under the terms of the GNU General Public License as published by
+ *     the Free Software Foundation, either version 3 of the License, or
+ *     (at your option) any later version.
+ * 
+ *     This program is distributed in the hope that it will be useful,
+ *     but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *     MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *     GNU General Public License for more details.
+ * 
+ *     You should have received a copy of the GNU General Public License
+ *     along with this program.  If not, see <https://www.gnu.org/licenses/>. 
+ *
+ **********/
+// headers
+#include <assert.h>
+#include "perftHashTable.h"
+
+namespace cchess_perft
+{
+namespace
+{
+    // data: the node count on the upper 56 bits, and the depth on the lower 8 bits
+    static constexpr unsigned int DEPTH_BITS = 8;
+    static constexpr std::uint64_t DEPTH_MASK = (1 << DEPTH_BITS) - 1;
+
+    std::size_t getNumberOfEntries(std::size_t sizeInBytes, std::size_t entrySize)
+    {
+        std::size_t ret = 1;
+        while(ret * 2 * entrySize <= sizeInBytes)
+            ret *= 2;
+
+        return ret;
+    }
+}
+    PerftHashTable::PerftHashTable(std::size_t sizeInMB, bool isLockless) :
+        m_entries(),
+        m_mask(getNumberOfEntries(sizeInMB * 1024 * 1024, sizeof(Entry)) - 1),
+        m_isLockless(isLockless),
+        m_locks()
+    {
+        m_entries.reset(new Entry[size()]);
+        for(std::size_t i = 0, i_size = size(); i < i_size; ++i) {
+            m_entries[i].keyXorData.store(0, std::memory_order_relaxed);
+            m_entries[i].data.store(0, std::memory_order_relaxed);
+        }
+
+        if(!m_isLockless)
+            m_locks.reset(new std::mutex[NUMBER_OF_LOCKS]);
+    }
+
+    bool PerftHashTable::probe(key_type key, unsigned int depth, std::uint64_t& nodes) const
+    {
+        auto index = getIndex(key, depth);
+        const auto& entry = m_entries[index];
+
+        std::uint64_t keyXorData, data;
+        if(m_isLockless) {
+            keyXorData = entry.keyXorData.load(std::memory_order_relaxed);
+            data = entry.data.load(std::memory_order_relaxed);
+        } else {
+            std::lock_guard<std::mutex> lock(m_locks[index % NUMBER_OF_LOCKS]);
+            keyXorData = entry.keyXorData.load(std::memory_order_relaxed);
+            data = entry.data.load(std::memory_order_relaxed);
+        }
+
+        // an empty entry has a depth of 0, which is never stored
+        if((keyXorData ^ data) == key && (data & DEPTH_MASK) == depth) {
+            nodes = data >> DEPTH_BITS;
+            return true;
+        }
+
+        return false;
+    }
+
+    void PerftHashTable::store(key_type key, unsigned int depth, std::uint64_t nodes)
+    {
+        assert(depth > 0 && depth <= DEPTH_MASK);
+        assert(nodes < (std::uint64_t(1) << (64 - DEPTH_BITS)));
+
+        // always replace
+        auto index = getIndex(key, depth);
+        auto& entry = m_entries[index];
+        auto data = (nodes << DEPTH_BITS) | depth;
+
+        if(m_isLockless) {
+            entry.keyXorData.store(key ^ data, std::memory_order_relaxed);
+            entry.data.store(data, std::memory_order_relaxed);
+        } else {
+            std::lock_guard<std::mutex> lock(m_locks[index % NUMBER_OF_LOCKS]);
+            entry.keyXorData.store(key ^ data, std::memory_order_relaxed);
+            entry.data.store(data, std::memory_order_relaxed);
+        }
+    }
+
+    std::size_t PerftHashTable::getIndex(key_type key, unsigned int depth) const
+    {
+        // the same position on different depths goes on different entries
+        return static_cast<std::size_t>(key ^ (depth * 0x9E3779B97F4A7C15ull)) & m_mask;
+    }
+}
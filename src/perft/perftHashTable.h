@@ -0,0 +1,62 @@
+/**********
+ *
+ *     This program is free software: you can redistribute it and/or modify
+ *     it under the terms of the GNU General Public License as published by
+ *     the Free Software Foundation, either version 3 of the License, or
+ *     (at your option) any later version.
+ * 
+ *     This program is distributed in the hope that it will be useful,
+ *     but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *     MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *     GNU General Public License for more details.
+ * 
+ *     You should have received a copy of the GNU General Public License
+ *     along with this program.  If not, see <https://www.gnu.org/licenses/>. 
+ *
+ **********/
+#pragma once
+
+// headers
+#include <atomic>
+#include <cinttypes>
+#include <memory>
+#include <mutex>
+
+namespace cchess_perft
+{
+    // a fixed size table of subtree node counts, keyed on the zobrist key and the depth.
+    // the number of entries is the largest power of two that fits in the given size.
+    //
+    // an entry is stored as the key xor-ed with the data, next to the data,
+    // so an entry torn by two threads writing it at once fails the key check.
+    // without lockless, a striped set of mutexes serializes the accesses instead
+    class PerftHashTable
+    {
+    public:
+        using key_type = std::uint64_t;
+
+        PerftHashTable(std::size_t sizeInMB, bool isLockless);
+
+        bool probe(key_type key, unsigned int depth, std::uint64_t& nodes) const;
+        void store(key_type key, unsigned int depth, std::uint64_t nodes);
+
+        std::size_t size() const { return m_mask + 1; }
+        bool isLockless() const { return m_isLockless; }
+
+    private:
+        static constexpr std::size_t NUMBER_OF_LOCKS = 1024;
+
+        struct Entry
+        {
+            std::atomic<std::uint64_t>  keyXorData;
+            std::atomic<std::uint64_t>  data;
+        };
+
+        std::size_t getIndex(key_type key, unsigned int depth) const;
+
+        std::unique_ptr<Entry[]>        m_entries;
+        std::size_t                     m_mask;
+        bool                            m_isLockless;
+        mutable std::unique_ptr<std::mutex[]> m_locks;
+    };
+}
@@ -0,0 +1,72 @@
+/**********
+ *
+ *     This program is free software: you can redistribute it and/or modify
+ *     it under the terms of the GNU General Public License as published by
+ *     the Free Software Foundation, either version 3 of the License, or
+ *     (at your option) any later version.
+ * 
+ *     This program is distributed in the hope that it will be useful,
+ *     but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *     MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *     GNU General Public License for more details.
+ * 
+ *     You should have received a copy of the GNU General Public License
+ *     along with this program.  If not, see <https://www.gnu.org/licenses/>. 
+ *
+ **********/
+// headers
+#include <assert.h>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include "mappedFile.h"
+
+namespace cchess_pgn
+{
+    MappedFile::MappedFile() :
+        m_data(nullptr),
+        m_size(0)
+    {
+    }
+
+    MappedFile::~MappedFile()
+    {
+        close();
+    }
+
+    bool MappedFile::open(const std::string& path)
+    {
+        close();
+
+        auto fileDescriptor = ::open(path.c_str(), O_RDONLY);
+        if(fileDescriptor < 0)
+            return false;
+
+        struct stat fileStatus;
+        auto isValid = fstat(fileDescriptor, &fileStatus) == 0;
+        if(isValid && fileStatus.st_size > 0) {
+            auto size = static_cast<std::size_t>(fileStatus.st_size);
+            auto data = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fileDescriptor, 0);
+            isValid = data != MAP_FAILED;
+            if(isValid) {
+                m_data = static_cast<const char*>(data);
+                m_size = size;
+            }
+        }
+
+        // the mapping stays valid without the file descriptor
+        ::close(fileDescriptor);
+
+        return isValid;
+    }
+
+    void MappedFile::close()
+    {
+        if(m_data)
+            munmap(const_cast<char*>(m_data), m_size);
+
+        m_data = nullptr;
+        m_size = 0;
+    }
+}
@@ -0,0 +1,179 @@
+/**********
+ *
+ *     This program is free software: you can redistribute it and/or modify
+ *     it under the terms of the GNU General Public License as published by
+ *     the Free Software Foundation, either version 3 of the License, or
+ *     (at your option) any later version.
+ * 
+ *     This program is distributed in the hope that it will be useful,
+ *     but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *     MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *     GNU General Public License for more details.
+ * 
+ *     You should have received a copy of the GNU General Public License
+ *     along with this program.  If not, see <https://www.gnu.org/licenses/>. 
+ *
+ **********/
+// headers
+#include <assert.h>
+#include <algorithm>
+#include <atomic>
+#include <fstream>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include "../chess/3rdparty/high_resolution_clock.h"
+#include "mappedFile.h"
+#include "pgnPipeline.h"
+
+namespace cchess_pgn
+{
+namespace
+{
+    // a part of the text with only complete games, and the games replayed from it
+    struct PgnChunk
+    {
+        PgnChunk(std::string_view text_) : text(text_), isDone(false) {}
+
+        std::string_view        text;
+        std::vector<PgnGame>    games;
+        bool                    isDone;
+    };
+
+    unsigned int getNumberOfThreads(unsigned int threads)
+    {
+        if(!threads)
+            threads = std::thread::hardware_concurrency();
+
+        return threads > 0 ? threads : 1;
+    }
+
+    // cuts the text at the first game start after every chunk size
+    std::vector<PgnChunk> splitChunks(std::string_view text, std::size_t chunkSize)
+    {
+        std::vector<PgnChunk> ret;
+
+        std::size_t start = 0;
+        while(start < text.size()) {
+            auto end = text.size();
+            if(text.size() - start > chunkSize)
+                end = std::min(findNextGameStart(text, start + chunkSize), text.size());
+
+            ret.emplace_back(text.substr(start, end - start));
+            start = end;
+        }
+
+        return ret;
+    }
+}
+    PgnPipeline::PgnPipeline(game_callback_type callback, unsigned int threads, std::size_t chunkSize) :
+        m_callback(std::move(callback)),
+        m_threads(getNumberOfThreads(threads)),
+        m_chunkSize(std::max<std::size_t>(chunkSize, 1)),
+        m_numberOfGames(0),
+        m_numberOfInvalidGames(0),
+        m_numberOfPlies(0)
+    {
+    }
+
+    void PgnPipeline::parse(std::string_view text, std::uint64_t baseOffset)
+    {
+        auto chunks = splitChunks(text, m_chunkSize);
+        auto threads = std::min<std::size_t>(m_threads, chunks.size());
+
+        std::atomic<std::size_t> nextChunk(0);
+        std::size_t nextChunkToMerge = 0;
+        std::mutex mergeMutex;
+        std::vector<std::thread> workers;
+        for(std::size_t i = 0; i < threads; ++i) {
+            workers.emplace_back([&]() {
+                // every thread replays on its own board, the games of a chunk are kept until
+                // the chunks before it are merged
+                std::vector<PgnGame>* games = nullptr;
+                PgnReader reader([&games](const PgnGame& game, const cchess::Chess&) {
+                    games->push_back(game);
+                });
+
+                for(auto index = nextChunk++; index < chunks.size(); index = nextChunk++) {
+                    auto& chunk = chunks[index];
+                    games = &chunk.games;
+                    reader.parse(chunk.text, baseOffset + static_cast<std::uint64_t>(chunk.text.data() - text.data()));
+
+                    // hand over every chunk that is done, in order
+                    std::lock_guard<std::mutex> lock(mergeMutex);
+                    chunk.isDone = true;
+                    for(; nextChunkToMerge < chunks.size() && chunks[nextChunkToMerge].isDone; ++nextChunkToMerge) {
+                        auto& mergedGames = chunks[nextChunkToMerge].games;
+                        for(const auto& game : mergedGames) {
+                            ++m_numberOfGames;
+                            m_numberOfPlies += game.plies;
+                            if(!game.isValid)
+                                ++m_numberOfInvalidGames;
+
+                            if(m_callback)
+                                m_callback(game);
+                        }
+                        std::vector<PgnGame>().swap(mergedGames);
+                    }
+                }
+            });
+        }
+
+        for(auto& worker : workers)
+            worker.join();
+
+        assert(nextChunkToMerge == chunks.size());
+    }
+
+    bool runPgnValidation(const std::string& path, const PgnValidationOptions& options, std::ostream& out)
+    {
+        mar::high_resolution_clock clock;
+        clock.start();
+
+        std::uint64_t gameNumber = 0;
+        auto printError = [&](const PgnGame& game) {
+            ++gameNumber;
+            if(!game.isValid)
+                out << path << ":" << game.errorOffset << ": game " << gameNumber << ": cannot play " << game.error << "\n";
+        };
+
+        std::uint64_t games = 0;
+        std::uint64_t invalidGames = 0;
+        std::uint64_t plies = 0;
+        if(options.threads == 1) {
+            std::ifstream in(path, std::ios::binary);
+            if(!in) {
+                out << "Cannot open: " << path << std::endl;
+                return false;
+            }
+
+            PgnReader reader([&](const PgnGame& game, const cchess::Chess&) { printError(game); });
+            reader.read(in);
+            games = reader.getNumberOfGames();
+            invalidGames = reader.getNumberOfInvalidGames();
+            plies = reader.getNumberOfPlies();
+        } else {
+            MappedFile file;
+            if(!file.open(path)) {
+                out << "Cannot open: " << path << std::endl;
+                return false;
+            }
+
+            PgnPipeline pipeline(printError, options.threads);
+            pipeline.parse(file.getText());
+            games = pipeline.getNumberOfGames();
+            invalidGames = pipeline.getNumberOfInvalidGames();
+            plies = pipeline.getNumberOfPlies();
+        }
+
+        auto elapsed = clock.get_elapsed();
+        auto seconds = elapsed.as_seconds();
+        out << "Games: " << games << "\n";
+        out << "Invalid games: " << invalidGames << "\n";
+        out << "Plies: " << plies << "\n";
+        out << "Time: " << elapsed.as_milliseconds() << " ms\n";
+        out << "Games/second: " << (seconds > 0.0 ? static_cast<std::uint64_t>(games / seconds) : games) << std::endl;
+
+        return true;
+    }
+}
@@ -0,0 +1,69 @@
+/**********
+ *
+ *     This program is free software: you can redistribute it and/or modify
+ *     it under the terms of the GNU General Public License as published by
+ *     the Free Software Foundation, either version 3 of the License, or
+ *     (at your option) any later version.
+ * 
+ *     This program is distributed in the hope that it will be useful,
+ *     but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *     MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *     GNU General Public License for more details.
+ * 
+ *     You should have received a copy of the GNU General Public License
+ *     along with this program.  If not, see <https://www.gnu.org/licenses/>. 
+ *
+ **********/
+#pragma once
+
+// headers
+#include <cinttypes>
+#include <functional>
+#include <ostream>
+#include <string>
+#include <string_view>
+#include "pgnReader.h"
+
+namespace cchess_pgn
+{
+    // replays the games of a whole text on several threads. the text is cut into chunks
+    // between two games, and every thread replays its chunks with its own reader and board.
+    // the games are handed to the callback one at a time, in the order of the text
+    class PgnPipeline
+    {
+    public:
+        using game_callback_type = std::function<void(const PgnGame& game)>;
+
+        static constexpr std::size_t DEFAULT_CHUNK_SIZE = 4 << 20;
+
+        // 0 threads uses every core
+        explicit PgnPipeline(game_callback_type callback = game_callback_type(), unsigned int threads = 0, std::size_t chunkSize = DEFAULT_CHUNK_SIZE);
+
+        // the views of the games point into the text, which has to outlive the callback
+        void parse(std::string_view text, std::uint64_t baseOffset = 0);
+
+        std::uint64_t getNumberOfGames() const { return m_numberOfGames; }
+        std::uint64_t getNumberOfInvalidGames() const { return m_numberOfInvalidGames; }
+        std::uint64_t getNumberOfPlies() const { return m_numberOfPlies; }
+
+    private:
+        game_callback_type  m_callback;
+        unsigned int        m_threads;
+        std::size_t         m_chunkSize;
+
+        std::uint64_t       m_numberOfGames;
+        std::uint64_t       m_numberOfInvalidGames;
+        std::uint64_t       m_numberOfPlies;
+    };
+
+    struct PgnValidationOptions
+    {
+        PgnValidationOptions() : threads(1) {}
+
+        unsigned int    threads;    // 1 streams the file, otherwise it is mapped in memory and split, 0 uses every core
+    };
+
+    // replays every game of the file, and prints the moves that can't be played with their offset.
+    // returns false if the file cannot be read
+    bool runPgnValidation(const std::string& path, const PgnValidationOptions& options, std::ostream& out);
+}
@@ -0,0 +1,350 @@
+/**********
+ *
+ *     This program is free software: you can redistribute it and/or modify
+ *     it under the terms of the GNU General Public License as published by
+ *     the Free Software Foundation, either version 3 of the License, or
+ *     (at your option) any later version.
+ * 
+ *     This program is distributed in the hope that it will be useful,
+ *     but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *     MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *     GNU General Public License for more details.
+ * 
+ *     You should have received a copy of the GNU General Public License
+ *     along with this program.  If not, see <https://www.gnu.org/licenses/>. 
+ *
+ **********/
+// headers
+#include <assert.h>
+#include <algorithm>
+#include <cstring>
+#include "../chess/move/moveNotation.h"
+#include "pgnReader.h"
+
+namespace cchess_pgn
+{
+namespace
+{
+    bool isSpace(char character)
+    {
+        return character == ' ' || character == '\t' || character == '\r' || character == '\n';
+    }
+
+    bool isDigit(char character)
+    {
+        return character >= '0' && character <= '9';
+    }
+
+    // a move can be followed right away by a comment, a variation or a NAG
+    bool isTokenEnd(char character)
+    {
+        return isSpace(character) || std::strchr("{}()[];$", character);
+    }
+
+    bool isResult(std::string_view token)
+    {
+        return token == "1-0" || token == "0-1" || token == "1/2-1/2" || token == "*";
+    }
+
+    std::size_t skipPast(std::string_view text, std::size_t index, char character)
+    {
+        index = text.find(character, index);
+        return index == std::string_view::npos ? text.size() : index + 1;
+    }
+
+    // whether the line that ends at the index is empty, the tags of a game are on consecutive lines
+    bool isAfterEmptyLine(std::string_view text, std::size_t lineEnd)
+    {
+        while(lineEnd > 0 && (text[lineEnd - 1] == '\r' || text[lineEnd - 1] == ' ' || text[lineEnd - 1] == '\t'))
+            --lineEnd;
+
+        return lineEnd > 0 && text[lineEnd - 1] == '\n';
+    }
+
+    // variations are not replayed, the comments in them can have parentheses
+    std::size_t skipVariation(std::string_view text, std::size_t index)
+    {
+        assert(text[index] == '(');
+        unsigned int depth = 0;
+        while(index < text.size()) {
+            auto character = text[index];
+            if(character == '{') {
+                index = skipPast(text, index, '}');
+                continue;
+            }
+
+            ++index;
+            if(character == '(')
+                ++depth;
+            else if(character == ')' && !--depth)
+                break;
+        }
+
+        return index;
+    }
+}
+    PgnReader::PgnReader(game_callback_type callback) :
+        m_callback(std::move(callback)),
+        m_startingPosition(m_chessboard.getPositionState()),
+        m_fenOffset(0),
+        m_isInGame(false),
+        m_isInMovetext(false),
+        m_numberOfGames(0),
+        m_numberOfInvalidGames(0),
+        m_numberOfPlies(0)
+    {
+    }
+
+    void PgnReader::read(std::istream& in, std::size_t bufferSize)
+    {
+        std::vector<char> buffer(std::max<std::size_t>(bufferSize, 1));
+        std::size_t size = 0;
+        std::uint64_t offset = 0;  // of the start of the buffer in the stream
+        while(true) {
+            // a single game that does not fit in the buffer
+            if(size == buffer.size())
+                buffer.resize(buffer.size() * 2);
+
+            in.read(buffer.data() + size, static_cast<std::streamsize>(buffer.size() - size));
+            size += static_cast<std::size_t>(in.gcount());
+
+            std::string_view text(buffer.data(), size);
+            if(!in) {
+                parse(text, offset);
+                break;
+            }
+
+            // the last game may go on in the next read, it is kept for it
+            auto gameStart = findLastGameStart(text);
+            if(gameStart == std::string_view::npos)
+                continue;
+
+            parse(text.substr(0, gameStart), offset);
+            std::memmove(buffer.data(), buffer.data() + gameStart, size - gameStart);
+            size -= gameStart;
+            offset += gameStart;
+        }
+    }
+
+    void PgnReader::parse(std::string_view text, std::uint64_t baseOffset)
+    {
+        std::size_t index = 0;
+        const auto size = text.size();
+        while(index < size) {
+            switch(text[index]) {
+            case ' ':
+            case '\t':
+            case '\r':
+            case '\n':
+            case ')':
+                ++index;
+                break;
+            case '[':
+                // a tag after the movetext starts the next game, even when the result is missing
+                if(!m_isInGame || m_isInMovetext)
+                    startGame(baseOffset + index);
+                index = parseTag(text, index, baseOffset);
+                break;
+            case '{':
+                index = skipPast(text, index, '}');
+                break;
+            case ';':
+            case '%':
+                index = skipPast(text, index, '\n');
+                break;
+            case '(':
+                index = skipVariation(text, index);
+                break;
+            case '$':
+                ++index;
+                while(index < size && isDigit(text[index]))
+                    ++index;
+                break;
+            default: {
+                // a stray closing character is skipped on its own
+                auto end = index;
+                while(end < size && !isTokenEnd(text[end]))
+                    ++end;
+                if(end == index)
+                    ++end;
+                else
+                    parseToken(text.substr(index, end - index), baseOffset + index);
+                index = end;
+                break;
+            }
+            }
+        }
+
+        if(m_isInGame)
+            finishGame();
+    }
+
+    std::size_t PgnReader::parseTag(std::string_view text, std::size_t index, std::uint64_t baseOffset)
+    {
+        // [Name "value"], where the value can escape \" and \\ in it
+        assert(text[index] == '[');
+        const auto tagOffset = baseOffset + index;
+        const auto size = text.size();
+
+        ++index;
+        while(index < size && isSpace(text[index]))
+            ++index;
+
+        auto nameStart = index;
+        while(index < size && !isSpace(text[index]) && text[index] != '"' && text[index] != ']')
+            ++index;
+        auto name = text.substr(nameStart, index - nameStart);
+
+        while(index < size && isSpace(text[index]))
+            ++index;
+
+        std::string_view value;
+        if(index < size && text[index] == '"') {
+            auto valueStart = ++index;
+            while(index < size && text[index] != '"')
+                index += text[index] == '\\' ? 2 : 1;
+            index = std::min(index, size);
+            value = text.substr(valueStart, index - valueStart);
+        }
+
+        m_game.tags.push_back({ name, value });
+        if(name == "FEN") {
+            m_fen = value;
+            m_fenOffset = tagOffset;
+        }
+
+        return skipPast(text, index, ']');
+    }
+
+    void PgnReader::parseToken(std::string_view token, std::uint64_t offset)
+    {
+        if(!m_isInGame)
+            startGame(offset);
+
+        if(isResult(token)) {
+            m_game.result = token;
+            finishGame();
+            return;
+        }
+
+        // move numbers, ex: 12. or 12... and sometimes the move written right after them
+        auto index = token.find_first_not_of("0123456789");
+        if(index == std::string_view::npos)
+            return;
+        if(token[index] == '.') {
+            index = token.find_first_not_of('.', index);
+            if(index == std::string_view::npos)
+                return;
+            token.remove_prefix(index);
+            offset += index;
+        }
+
+        // an en passant capture is sometimes marked after the move
+        if(token == "e.p.")
+            return;
+
+        playMove(token, offset);
+    }
+
+    void PgnReader::startGame(std::uint64_t offset)
+    {
+        if(m_isInGame)
+            finishGame();
+
+        m_game.offset = offset;
+        m_game.tags.clear();
+        m_game.result = std::string_view();
+        m_game.plies = 0;
+        m_game.isValid = true;
+        m_game.errorOffset = 0;
+        m_game.error = std::string_view();
+        m_fen = std::string_view();
+        m_isInGame = true;
+        m_isInMovetext = false;
+    }
+
+    void PgnReader::setupGame()
+    {
+        // the tags are over, the game starts from the FEN tag when there is one
+        m_isInMovetext = true;
+        m_chessboard.setPositionState(m_startingPosition);
+        if(!m_fen.empty() && !m_chessboard.setFromFEN(m_fen)) {
+            m_game.isValid = false;
+            m_game.errorOffset = m_fenOffset;
+            m_game.error = m_fen;
+        }
+    }
+
+    void PgnReader::playMove(std::string_view san, std::uint64_t offset)
+    {
+        if(!m_isInMovetext)
+            setupGame();
+
+        // the rest of a game is skipped after its first error
+        if(!m_game.isValid)
+            return;
+
+        m_chessboard.generateLegalMoves(m_chessboard.getCurrentColorsTurn(), m_legalMoves);
+        auto move = cchess::findSANMove(san, m_chessboard, m_legalMoves);
+        if(move.isEmpty()) {
+            m_game.isValid = false;
+            m_game.errorOffset = offset;
+            m_game.error = san;
+            return;
+        }
+
+        m_chessboard.doMove(move);
+        ++m_game.plies;
+    }
+
+    void PgnReader::finishGame()
+    {
+        // a game without moves still has a position
+        if(!m_isInMovetext)
+            setupGame();
+
+        ++m_numberOfGames;
+        m_numberOfPlies += m_game.plies;
+        if(!m_game.isValid)
+            ++m_numberOfInvalidGames;
+
+        if(m_callback)
+            m_callback(m_game, m_chessboard);
+
+        m_isInGame = false;
+        m_isInMovetext = false;
+    }
+
+    std::size_t findNextGameStart(std::string_view text, std::size_t index)
+    {
+        while(index < text.size()) {
+            auto lineStart = text.find("\n[", index);
+            if(lineStart == std::string_view::npos)
+                break;
+
+            if(isAfterEmptyLine(text, lineStart))
+                return lineStart + 1;
+
+            index = lineStart + 1;
+        }
+
+        return std::string_view::npos;
+    }
+
+    std::size_t findLastGameStart(std::string_view text)
+    {
+        auto index = text.size();
+        while(index > 0) {
+            auto lineStart = text.rfind("\n[", index - 1);
+            if(lineStart == std::string_view::npos)
+                break;
+
+            if(isAfterEmptyLine(text, lineStart))
+                return lineStart + 1;
+
+            index = lineStart;
+        }
+
+        return std::string_view::npos;
+    }
+}
@@ -0,0 +1,101 @@
+/**********
+ *
+ *     This program is free software: you can redistribute it and/or modify
+ *     it under the terms of the GNU General Public License as published by
+ *     the Free Software Foundation, either version 3 of the License, or
+ *     (at your option) any later version.
+ * 
+ *     This program is distributed in the hope that it will be useful,
+ *     but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *     MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *     GNU General Public License for more details.
+ * 
+ *     You should have received a copy of the GNU General Public License
+ *     along with this program.  If not, see <https://www.gnu.org/licenses/>. 
+ *
+ **********/
+#pragma once
+
+// headers
+#include <cinttypes>
+#include <functional>
+#include <istream>
+#include <string_view>
+#include <vector>
+#include "../chess/chess.h"
+
+namespace cchess_pgn
+{
+    struct PgnTag
+    {
+        std::string_view    name;
+        std::string_view    value;  // as written, with the escapes
+    };
+
+    // a game as it is replayed, the views point into the text being read,
+    // so they are only valid while the game is handed to the callback
+    struct PgnGame
+    {
+        PgnGame() : offset(0), plies(0), isValid(true), errorOffset(0) {}
+
+        std::uint64_t           offset;         // of the first character of the game in the stream
+        std::vector<PgnTag>     tags;
+        std::string_view        result;         // empty when the movetext has no result
+        unsigned int            plies;          // the moves played before the end, or before the error
+        bool                    isValid;
+        std::uint64_t           errorOffset;    // of the move that can't be played, or of the FEN tag
+        std::string_view        error;          // the move, or the FEN
+    };
+
+    // reads the games of a PGN text, and replays every move with the rules of the chess board.
+    // the text is tokenized in place, nothing is copied but the tags of the current game
+    class PgnReader
+    {
+    public:
+        using game_callback_type = std::function<void(const PgnGame& game, const cchess::Chess& chessboard)>;
+
+        static constexpr std::size_t DEFAULT_BUFFER_SIZE = 1 << 20;
+
+        explicit PgnReader(game_callback_type callback = game_callback_type());
+
+        // reads the whole stream, a buffer at a time, and cuts the buffer between two games
+        void read(std::istream& in, std::size_t bufferSize = DEFAULT_BUFFER_SIZE);
+
+        // reads complete games, the text ends with the end of its last game.
+        // the offsets of the games are counted from baseOffset
+        void parse(std::string_view text, std::uint64_t baseOffset = 0);
+
+        std::uint64_t getNumberOfGames() const { return m_numberOfGames; }
+        std::uint64_t getNumberOfInvalidGames() const { return m_numberOfInvalidGames; }
+        std::uint64_t getNumberOfPlies() const { return m_numberOfPlies; }
+
+    private:
+        std::size_t parseTag(std::string_view text, std::size_t index, std::uint64_t baseOffset);
+        void parseToken(std::string_view token, std::uint64_t offset);
+
+        void startGame(std::uint64_t offset);
+        void setupGame();
+        void playMove(std::string_view san, std::uint64_t offset);
+        void finishGame();
+
+        game_callback_type              m_callback;
+        cchess::Chess                   m_chessboard;
+        cchess::Chess::PositionState    m_startingPosition;
+        cchess::MoveList                m_legalMoves;
+
+        PgnGame                         m_game;
+        std::string_view                m_fen;
+        std::uint64_t                   m_fenOffset;
+        bool                            m_isInGame;
+        bool                            m_isInMovetext;
+
+        std::uint64_t                   m_numberOfGames;
+        std::uint64_t                   m_numberOfInvalidGames;
+        std::uint64_t                   m_numberOfPlies;
+    };
+
+    // a game starts with a tag right after an empty line, like the [Event tag of the export format.
+    // the start of the first game from index, or of the last game of the text, npos when there is none
+    std::size_t findNextGameStart(std::string_view text, std::size_t index);
+    std::size_t findLastGameStart(std::string_view text);
+}